@@ -0,0 +1,131 @@
+/*
+ * Shared timing harness for the native microbenchmarks in bench/
+ *
+ * Each benchmarked kernel is a void (*)(void *) that processes a fixed
+ * number of bytes per call. bench_run calibrates a repetition count so
+ * one sample takes about BENCH_SAMPLE_NS, takes BENCH_SAMPLES samples,
+ * and prints ONE JSON line per (kernel, variant):
+ *
+ *   {"kernel":"aes_encrypt","variant":"ttable","reference":"bcon",
+ *    "bytes":4096,"reps":..,"ns_p50":..,"ns_p90":..,"ns_p99":..,
+ *    "mb_per_s":..,"cycles_per_byte":..}
+ *
+ * ns_p* are per-call latency percentiles over the samples, mb_per_s is
+ * throughput over all samples and cycles_per_byte is the median sample
+ * in x86 TSC ticks (null elsewhere). "reference" names the variant this
+ * one was verified against; the reference row has variant == reference.
+ *
+ * Sanity checks against the reference happen in each bench_*.c before
+ * any timing; bench_fail reports a mismatch and stops the run.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+#ifndef BENCH_SAMPLES
+#define BENCH_SAMPLES 101
+#endif
+
+#ifndef BENCH_SAMPLE_NS
+#define BENCH_SAMPLE_NS 200000.0
+#endif
+
+typedef void (*bench_fn)(void *arg);
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static unsigned long long bench_cycles(void)
+{
+#if BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static int bench_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted array
+static double bench_percentile(const double *sorted, int n, int pct)
+{
+    int i = (pct * n + 99) / 100 - 1;
+    return sorted[i < 0 ? 0 : i];
+}
+
+static void bench_fail(const char *kernel, const char *variant, const char *reference)
+{
+    fprintf(stderr, "%s/%s: MISMATCH against %s\n", kernel, variant, reference);
+    exit(1);
+}
+
+static void bench_run(const char *kernel, const char *variant, const char *reference,
+                      size_t bytes, bench_fn fn, void *arg)
+{
+    double ns[BENCH_SAMPLES], cyc[BENCH_SAMPLES];
+    double t0, t, total = 0;
+    unsigned long long c0;
+    long reps = 1, r;
+    int s;
+
+    // Warm up, then double reps until one sample is long enough to time
+    fn(arg);
+    for (;;) {
+        t0 = bench_now_ns();
+        for (r = 0; r < reps; r++)
+            fn(arg);
+        if (bench_now_ns() - t0 >= BENCH_SAMPLE_NS || reps >= (1L << 24))
+            break;
+        reps *= 2;
+    }
+
+    for (s = 0; s < BENCH_SAMPLES; s++) {
+        t0 = bench_now_ns();
+        c0 = bench_cycles();
+        for (r = 0; r < reps; r++)
+            fn(arg);
+        cyc[s] = (double)(bench_cycles() - c0);
+        t = bench_now_ns() - t0;
+        total += t;
+        ns[s] = t / reps;
+    }
+    qsort(ns, BENCH_SAMPLES, sizeof(ns[0]), bench_cmp_double);
+    qsort(cyc, BENCH_SAMPLES, sizeof(cyc[0]), bench_cmp_double);
+
+    printf("{\"kernel\":\"%s\",\"variant\":\"%s\",\"reference\":\"%s\","
+           "\"bytes\":%zu,\"reps\":%ld,"
+           "\"ns_p50\":%.2f,\"ns_p90\":%.2f,\"ns_p99\":%.2f,\"mb_per_s\":%.2f,",
+           kernel, variant, reference, bytes, reps,
+           bench_percentile(ns, BENCH_SAMPLES, 50),
+           bench_percentile(ns, BENCH_SAMPLES, 90),
+           bench_percentile(ns, BENCH_SAMPLES, 99),
+           (double)bytes * reps * BENCH_SAMPLES / total * 1e3);
+    if (BENCH_HAVE_TSC)
+        printf("\"cycles_per_byte\":%.3f}\n",
+               bench_percentile(cyc, BENCH_SAMPLES, 50) / ((double)reps * bytes));
+    else
+        printf("\"cycles_per_byte\":null}\n");
+    fflush(stdout);
+}
+
+#endif
@@ -0,0 +1,168 @@
+/*
+ * Native microbenchmark: AES-128 block cipher variants
+ *
+ *   aes_encrypt  bcon (B-Con aes_encrypt, reference), ttable, bitsliced
+ *                (8 blocks per call), key_ctx, aesni
+ *   aes_decrypt  bcon (reference), key_ctx (equivalent inverse cipher),
+ *                aesni
+ *
+ * aes_key_ctx.c includes the original aes.c, so this file gets the
+ * reference through it; aes_ttable.c, aes_bitsliced.c and aes_ni.c only
+ * need aes.h and are linked as separate objects. The AES-NI rows are
+ * compiled in on x86-64 (-DBENCH_AESNI) and run only if the CPU has AES.
+ */
+
+#include "../experiments/crypto-algorithms/aes/aes_key_ctx.c"
+#include "bench.h"
+
+void aes_encrypt_ttable(const BYTE in[], BYTE out[], const WORD key[], int keysize);
+void aes128_encrypt_bitsliced(const BYTE in[], BYTE out[], const WORD key[]);
+#ifdef BENCH_AESNI
+void aes128_key_setup_aesni(const BYTE key[16], BYTE rk[176]);
+void aes128_decrypt_key_aesni(const BYTE rk[176], BYTE dk[176]);
+void aes128_encrypt_aesni(const BYTE in[16], BYTE out[16], const BYTE rk[176]);
+void aes128_decrypt_aesni(const BYTE in[16], BYTE out[16], const BYTE dk[176]);
+#endif
+
+#define BENCH_AES_BLOCKS 256
+
+static BYTE aes_in[AES_BLOCK_SIZE * BENCH_AES_BLOCKS];
+static BYTE aes_ref[AES_BLOCK_SIZE * BENCH_AES_BLOCKS];
+static BYTE aes_out[AES_BLOCK_SIZE * BENCH_AES_BLOCKS];
+static WORD aes_sched[60];
+static aes_key_ctx aes_ctx;
+#ifdef BENCH_AESNI
+static BYTE aesni_rk[176], aesni_dk[176];
+#endif
+
+static void run_enc_bcon(void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < BENCH_AES_BLOCKS; i++)
+        aes_encrypt(&aes_in[16 * i], &aes_out[16 * i], aes_sched, 128);
+}
+
+static void run_enc_ttable(void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < BENCH_AES_BLOCKS; i++)
+        aes_encrypt_ttable(&aes_in[16 * i], &aes_out[16 * i], aes_sched, 128);
+}
+
+static void run_enc_bitsliced(void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < BENCH_AES_BLOCKS; i += 8)
+        aes128_encrypt_bitsliced(&aes_in[16 * i], &aes_out[16 * i], aes_sched);
+}
+
+static void run_enc_key_ctx(void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < BENCH_AES_BLOCKS; i++)
+        aes_ctx_encrypt(&aes_ctx, &aes_in[16 * i], &aes_out[16 * i]);
+}
+
+static void run_dec_bcon(void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < BENCH_AES_BLOCKS; i++)
+        aes_decrypt(&aes_in[16 * i], &aes_out[16 * i], aes_sched, 128);
+}
+
+static void run_dec_key_ctx(void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < BENCH_AES_BLOCKS; i++)
+        aes_ctx_decrypt(&aes_ctx, &aes_in[16 * i], &aes_out[16 * i]);
+}
+
+#ifdef BENCH_AESNI
+static void run_enc_aesni(void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < BENCH_AES_BLOCKS; i++)
+        aes128_encrypt_aesni(&aes_in[16 * i], &aes_out[16 * i], aesni_rk);
+}
+
+static void run_dec_aesni(void *arg)
+{
+    int i;
+    (void)arg;
+    for (i = 0; i < BENCH_AES_BLOCKS; i++)
+        aes128_decrypt_aesni(&aes_in[16 * i], &aes_out[16 * i], aesni_dk);
+}
+#endif
+
+// Run once into aes_out and compare with the reference output
+static void check(const char *kernel, const char *variant, bench_fn fn)
+{
+    memset(aes_out, 0, sizeof(aes_out));
+    fn(NULL);
+    if (memcmp(aes_out, aes_ref, sizeof(aes_ref)) != 0)
+        bench_fail(kernel, variant, "bcon");
+}
+
+int main(void)
+{
+    BYTE key[16];
+    int i, have_aesni = 0;
+
+    srand(1);
+    for (i = 0; i < (int)sizeof(aes_in); i++)
+        aes_in[i] = (BYTE)rand();
+    for (i = 0; i < 16; i++)
+        key[i] = (BYTE)rand();
+
+    aes_key_setup(key, aes_sched, 128);
+    aes_key_ctx_init(&aes_ctx, key, 128);
+#ifdef BENCH_AESNI
+    have_aesni = __builtin_cpu_supports("aes");
+    if (have_aesni) {
+        aes128_key_setup_aesni(key, aesni_rk);
+        aes128_decrypt_key_aesni(aesni_rk, aesni_dk);
+    }
+#endif
+
+    run_enc_bcon(NULL);
+    memcpy(aes_ref, aes_out, sizeof(aes_ref));
+    check("aes_encrypt", "ttable", run_enc_ttable);
+    check("aes_encrypt", "bitsliced", run_enc_bitsliced);
+    check("aes_encrypt", "key_ctx", run_enc_key_ctx);
+#ifdef BENCH_AESNI
+    if (have_aesni)
+        check("aes_encrypt", "aesni", run_enc_aesni);
+#endif
+
+    bench_run("aes_encrypt", "bcon", "bcon", sizeof(aes_in), run_enc_bcon, NULL);
+    bench_run("aes_encrypt", "ttable", "bcon", sizeof(aes_in), run_enc_ttable, NULL);
+    bench_run("aes_encrypt", "bitsliced", "bcon", sizeof(aes_in), run_enc_bitsliced, NULL);
+    bench_run("aes_encrypt", "key_ctx", "bcon", sizeof(aes_in), run_enc_key_ctx, NULL);
+#ifdef BENCH_AESNI
+    if (have_aesni)
+        bench_run("aes_encrypt", "aesni", "bcon", sizeof(aes_in), run_enc_aesni, NULL);
+#endif
+
+    run_dec_bcon(NULL);
+    memcpy(aes_ref, aes_out, sizeof(aes_ref));
+    check("aes_decrypt", "key_ctx", run_dec_key_ctx);
+#ifdef BENCH_AESNI
+    if (have_aesni)
+        check("aes_decrypt", "aesni", run_dec_aesni);
+#endif
+
+    bench_run("aes_decrypt", "bcon", "bcon", sizeof(aes_in), run_dec_bcon, NULL);
+    bench_run("aes_decrypt", "key_ctx", "bcon", sizeof(aes_in), run_dec_key_ctx, NULL);
+#ifdef BENCH_AESNI
+    if (have_aesni)
+        bench_run("aes_decrypt", "aesni", "bcon", sizeof(aes_in), run_dec_aesni, NULL);
+#endif
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*
+ * Native microbenchmark: FEAL-8 1989 Encrypt/Decrypt variants
+ *
+ *   Encrypt  original (reference), rot2, ctx, fast, ecb (EncryptECB_fast
+ *            over the whole buffer), cbc (EncryptCBC_fast)
+ *   Decrypt  original (reference), fast, ecb, cbc (DecryptCBC_fast)
+ *
+ * feal8_1989_batch.c pulls in every variant down to the original
+ * feal8_1989_portable.c. The cbc rows are checked against the original
+ * Encrypt / Decrypt with the chaining XORs written out (cbc_original),
+ * and DecryptCBC_fast with In == Out (the case
+ * feal8_1989_batch_verify.saw leaves out) must give back the input too.
+ */
+
+#include "../experiments/feal/feal8_1989_batch.c"
+#include "bench.h"
+
+#define BENCH_FEAL_BLOCKS 512
+
+static ByteType feal_in[FEAL_BLOCK_SIZE * BENCH_FEAL_BLOCKS];
+static ByteType feal_ref[FEAL_BLOCK_SIZE * BENCH_FEAL_BLOCKS];
+static ByteType feal_out[FEAL_BLOCK_SIZE * BENCH_FEAL_BLOCKS];
+static ByteType feal_ct[FEAL_BLOCK_SIZE * BENCH_FEAL_BLOCKS];
+static FEAL_KEY feal_key;
+static ByteType feal_iv[FEAL_BLOCK_SIZE];
+
+#define FEAL_BLOCK_BENCH(name, call)                         \
+    static void run_##name(void *arg)                        \
+    {                                                        \
+        int i;                                               \
+        (void)arg;                                           \
+        for (i = 0; i < BENCH_FEAL_BLOCKS; i++)              \
+            call(feal_in + 8 * i, feal_out + 8 * i);         \
+    }
+
+#define FEAL_CTX_BENCH(name, call)                           \
+    static void run_##name(void *arg)                        \
+    {                                                        \
+        int i;                                               \
+        (void)arg;                                           \
+        for (i = 0; i < BENCH_FEAL_BLOCKS; i++)              \
+            call(&feal_key, feal_in + 8 * i, feal_out + 8 * i); \
+    }
+
+FEAL_BLOCK_BENCH(enc_original, Encrypt)
+FEAL_BLOCK_BENCH(enc_rot2, Encrypt_pure)
+FEAL_CTX_BENCH(enc_ctx, Encrypt_ctx)
+FEAL_CTX_BENCH(enc_fast, Encrypt_fast)
+FEAL_BLOCK_BENCH(dec_original, Decrypt)
+FEAL_CTX_BENCH(dec_fast, Decrypt_fast)
+
+static void run_enc_ecb(void *arg)
+{
+    (void)arg;
+    EncryptECB_fast(&feal_key, feal_in, feal_out, BENCH_FEAL_BLOCKS);
+}
+
+static void run_dec_ecb(void *arg)
+{
+    (void)arg;
+    DecryptECB_fast(&feal_key, feal_in, feal_out, BENCH_FEAL_BLOCKS);
+}
+
+static void run_enc_cbc(void *arg)
+{
+    (void)arg;
+    EncryptCBC_fast(&feal_key, feal_iv, feal_in, feal_out, BENCH_FEAL_BLOCKS);
+}
+
+static void run_dec_cbc(void *arg)
+{
+    (void)arg;
+    DecryptCBC_fast(&feal_key, feal_iv, feal_ct, feal_out, BENCH_FEAL_BLOCKS);
+}
+
+// CBC reference on the original global-key Encrypt / Decrypt
+static void cbc_original(int decrypt, const ByteType *in, ByteType *out)
+{
+    ByteType chain[FEAL_BLOCK_SIZE], block[FEAL_BLOCK_SIZE];
+    int i, j;
+
+    memcpy(chain, feal_iv, sizeof(chain));
+    for (i = 0; i < BENCH_FEAL_BLOCKS; i++) {
+        const ByteType *c = in + 8 * i;
+        ByteType *o = out + 8 * i;
+        if (decrypt) {
+            Decrypt((ByteType *)c, block);
+            for (j = 0; j < FEAL_BLOCK_SIZE; j++)
+                o[j] = block[j] ^ chain[j];
+            memcpy(chain, c, sizeof(chain));
+        } else {
+            for (j = 0; j < FEAL_BLOCK_SIZE; j++)
+                block[j] = c[j] ^ chain[j];
+            Encrypt(block, o);
+            memcpy(chain, o, sizeof(chain));
+        }
+    }
+}
+
+static void check(const char *kernel, const char *variant, bench_fn fn)
+{
+    memset(feal_out, 0, sizeof(feal_out));
+    fn(NULL);
+    if (memcmp(feal_out, feal_ref, sizeof(feal_ref)) != 0)
+        bench_fail(kernel, variant, "original");
+}
+
+int main(void)
+{
+    ByteType key[8] = {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef};
+    int i;
+
+    srand(1);
+    for (i = 0; i < (int)sizeof(feal_in); i++)
+        feal_in[i] = (ByteType)rand();
+    for (i = 0; i < FEAL_BLOCK_SIZE; i++)
+        feal_iv[i] = (ByteType)rand();
+    SetKey(key);
+    SetKey_fast(&feal_key, key);
+
+    run_enc_original(NULL);
+    memcpy(feal_ref, feal_out, sizeof(feal_ref));
+    check("Encrypt", "rot2", run_enc_rot2);
+    check("Encrypt", "ctx", run_enc_ctx);
+    check("Encrypt", "fast", run_enc_fast);
+    check("Encrypt", "ecb", run_enc_ecb);
+
+    bench_run("Encrypt", "original", "original", sizeof(feal_in), run_enc_original, NULL);
+    bench_run("Encrypt", "rot2", "original", sizeof(feal_in), run_enc_rot2, NULL);
+    bench_run("Encrypt", "ctx", "original", sizeof(feal_in), run_enc_ctx, NULL);
+    bench_run("Encrypt", "fast", "original", sizeof(feal_in), run_enc_fast, NULL);
+    bench_run("Encrypt", "ecb", "original", sizeof(feal_in), run_enc_ecb, NULL);
+
+    run_dec_original(NULL);
+    memcpy(feal_ref, feal_out, sizeof(feal_ref));
+    check("Decrypt", "fast", run_dec_fast);
+    check("Decrypt", "ecb", run_dec_ecb);
+
+    bench_run("Decrypt", "original", "original", sizeof(feal_in), run_dec_original, NULL);
+    bench_run("Decrypt", "fast", "original", sizeof(feal_in), run_dec_fast, NULL);
+    bench_run("Decrypt", "ecb", "original", sizeof(feal_in), run_dec_ecb, NULL);
+
+    cbc_original(0, feal_in, feal_ref);
+    check("Encrypt", "cbc", run_enc_cbc);
+    memcpy(feal_ct, feal_ref, sizeof(feal_ct));
+    cbc_original(1, feal_ct, feal_ref);
+    check("Decrypt", "cbc", run_dec_cbc);
+    memcpy(feal_out, feal_ct, sizeof(feal_out));
+    DecryptCBC_fast(&feal_key, feal_iv, feal_out, feal_out, BENCH_FEAL_BLOCKS);
+    if (memcmp(feal_out, feal_in, sizeof(feal_in)) != 0)
+        bench_fail("Decrypt", "cbc (In == Out)", "input");
+
+    bench_run("Encrypt", "cbc", "original", sizeof(feal_in), run_enc_cbc, NULL);
+    bench_run("Decrypt", "cbc", "original", sizeof(feal_in), run_dec_cbc, NULL);
+    return 0;
+}
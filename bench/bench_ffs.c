@@ -0,0 +1,98 @@
+/*
+ * Native microbenchmark: ffs variants and the bitmap scanner
+ *
+ *   ffs          ref (loop) and every variant registered in
+ *                ffs_variants.h (imp, musl, ctz, ...) over BENCH_FFS_WORDS
+ *                random words, all proved equal to ffs_ref by make verify
+ *   bitmap_scan  find_first_set_in_bitmap vs a word-at-a-time ffs_ref
+ *                scan, worst case: only the last bit of the map is set
+ */
+
+#include "../experiments/ffs/ffs_variants.c"
+#include "bench.h"
+
+#define BENCH_FFS_WORDS 1024
+#define BENCH_BITMAP_WORDS 512
+
+static uint32_t ffs_words[BENCH_FFS_WORDS];
+static uint64_t bitmap[BENCH_BITMAP_WORDS];
+static volatile uint32_t ffs_sink;
+static volatile size_t bitmap_sink;
+
+#define FFS_BENCH(name)                                  \
+    static void run_##name(void *arg)                    \
+    {                                                    \
+        uint32_t acc = 0;                                \
+        int i;                                           \
+        (void)arg;                                       \
+        for (i = 0; i < BENCH_FFS_WORDS; i++)            \
+            acc += name(ffs_words[i]);                   \
+        ffs_sink = acc;                                  \
+    }
+
+// Direct calls, not through the table's pointer, so that each variant
+// is timed as its callers would inline it
+#define FFS_VARIANT_BENCH(name, what) FFS_BENCH(ffs_##name)
+FFS_BENCH(ffs_ref)
+FFS_VARIANTS(FFS_VARIANT_BENCH)
+
+#define FFS_VARIANT_RUN(name, what) run_ffs_##name,
+static void (*const ffs_runs[])(void *) = {
+    FFS_VARIANTS(FFS_VARIANT_RUN)
+};
+
+// What find_first_set_in_bitmap replaces: test each 32-bit half in turn
+static size_t bitmap_naive(const uint64_t *map, size_t nwords)
+{
+    size_t i;
+
+    for (i = 0; i < nwords; i++) {
+        if ((uint32_t)map[i] != 0)
+            return 64 * i + ffs_ref((uint32_t)map[i]);
+        if ((uint32_t)(map[i] >> 32) != 0)
+            return 64 * i + 32 + ffs_ref((uint32_t)(map[i] >> 32));
+    }
+    return 0;
+}
+
+static void run_bitmap_naive(void *arg)
+{
+    (void)arg;
+    bitmap_sink = bitmap_naive(bitmap, BENCH_BITMAP_WORDS);
+}
+
+static void run_bitmap_scan(void *arg)
+{
+    (void)arg;
+    bitmap_sink = find_first_set_in_bitmap(bitmap, BENCH_BITMAP_WORDS);
+}
+
+int main(void)
+{
+    size_t v;
+    int i;
+
+    srand(1);
+    // Random words shifted left by a random amount, so the first set bit
+    // is spread over all 32 positions; every 64th word is zero
+    for (i = 0; i < BENCH_FFS_WORDS; i++)
+        ffs_words[i] = (i % 64 == 0) ? 0 :
+            ((uint32_t)rand() ^ ((uint32_t)rand() << 16)) << (rand() % 32);
+    for (i = 0; i < BENCH_FFS_WORDS; i++) {
+        uint32_t r = ffs_ref(ffs_words[i]);
+        for (v = 0; v < FFS_NVARIANTS; v++)
+            if (ffs_variants[v].fn(ffs_words[i]) != r)
+                bench_fail("ffs", ffs_variants[v].name, "ref");
+    }
+
+    bitmap[BENCH_BITMAP_WORDS - 1] = 1ull << 63;
+    if (find_first_set_in_bitmap(bitmap, BENCH_BITMAP_WORDS) != bitmap_naive(bitmap, BENCH_BITMAP_WORDS))
+        bench_fail("bitmap_scan", "bitmap", "naive");
+
+    bench_run("ffs", "ref", "ref", 4 * BENCH_FFS_WORDS, run_ffs_ref, NULL);
+    for (v = 0; v < FFS_NVARIANTS; v++)
+        bench_run("ffs", ffs_variants[v].name, "ref", 4 * BENCH_FFS_WORDS, ffs_runs[v], NULL);
+    bench_run("bitmap_scan", "naive", "naive", 8 * BENCH_BITMAP_WORDS, run_bitmap_naive, NULL);
+    bench_run("bitmap_scan", "bitmap", "naive", 8 * BENCH_BITMAP_WORDS, run_bitmap_scan, NULL);
+    return 0;
+}
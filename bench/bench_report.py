@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Summarise bench/ results and check them against a saved baseline.
+
+  bench_report.py results.jsonl
+      Table of every (kernel, variant) row with its speedup over the
+      reference variant it was verified against.
+
+  bench_report.py results.jsonl --baseline baseline.jsonl [--tolerance 10]
+      Also compare each row with the baseline and exit 1 if any variant
+      got slower by more than --tolerance percent. The metric is
+      cycles_per_byte (x86 TSC) when both runs have it, ns_p50 otherwise.
+      With --warn-only regressions are reported but the exit status is 0.
+
+  bench_report.py results.jsonl --ct ct.jsonl
+      Add the constant-time column from make ct: "yes", or the number of
+      secret-dependent branches / addresses / divisions in the variant.
+
+Input is the JSON-lines output of the bench_* binaries (see bench.h).
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    rows = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line:
+                r = json.loads(line)
+                rows[(r["kernel"], r["variant"])] = r
+    return rows
+
+
+def cost(r, use_cycles):
+    """Per-byte cost: TSC cycles if available, else median ns."""
+    if use_cycles:
+        return r["cycles_per_byte"]
+    return r["ns_p50"] / r["bytes"]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("results")
+    ap.add_argument("--baseline")
+    ap.add_argument("--tolerance", type=float, default=10.0,
+                    help="allowed slowdown vs baseline, percent (default 10)")
+    ap.add_argument("--warn-only", action="store_true",
+                    help="report regressions without failing")
+    ap.add_argument("--ct", help="ct.jsonl from make ct (scripts/ct-check.py)")
+    args = ap.parse_args()
+
+    rows = load(args.results)
+    base = load(args.baseline) if args.baseline else {}
+    ct = load(args.ct) if args.ct else {}
+    use_cycles = all(r["cycles_per_byte"] is not None for r in rows.values())
+    unit = "cyc/B" if use_cycles else "ns/B"
+
+    print(f"{'kernel':<15} {'variant':<11} {unit:>8} {'MB/s':>9} "
+          f"{'p50 ns':>10} {'p99 ns':>10} {'vs ref':>7} {'vs base':>8}"
+          + (f" {'const-time':>10}" if ct else ""))
+    regressions = []
+    for key in sorted(rows):
+        r = rows[key]
+        c = cost(r, use_cycles)
+        ref = rows.get((r["kernel"], r["reference"]))
+        speedup = f"{cost(ref, use_cycles) / c:6.2f}x" if ref else "      -"
+        delta = "       -"
+        b = base.get(key)
+        if b is not None:
+            both = use_cycles and b["cycles_per_byte"] is not None
+            bc = cost(b, both)
+            c = cost(r, both)
+            pct = (c - bc) / bc * 100.0
+            delta = f"{pct:+7.1f}%"
+            if pct > args.tolerance:
+                regressions.append((key, pct))
+        side = ""
+        if ct:
+            c_row = ct.get(key)
+            side = (" " + ("-" if c_row is None else "yes" if c_row["constant_time"]
+                           else f"{c_row['sites']} leaks").rjust(10))
+        print(f"{r['kernel']:<15} {r['variant']:<11} {cost(r, use_cycles):8.3f} "
+              f"{r['mb_per_s']:9.1f} {r['ns_p50']:10.1f} {r['ns_p99']:10.1f} "
+              f"{speedup} {delta}{side}")
+
+    missing = sorted(set(base) - set(rows))
+    for kernel, variant in missing:
+        print(f"{kernel}/{variant}: in baseline but not in results")
+
+    if regressions:
+        print("")
+        for (kernel, variant), pct in regressions:
+            print(f"REGRESSION: {kernel}/{variant} {pct:+.1f}% "
+                  f"(tolerance {args.tolerance:.0f}%)")
+        return 0 if args.warn_only else 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
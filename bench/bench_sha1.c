@@ -0,0 +1,186 @@
+/*
+ * Native microbenchmark: SHA-1 transform and update variants
+ *
+ * Every variant includes sha1_single_round.c (the decomposed transform
+ * its proof is stated against), so one translation unit can hold only
+ * one of them. This file is built three times (see Makefile):
+ *
+ *   bench_sha1              sha1_transform: decomposed (reference),
+ *                           unrolled, mb4 (4 lanes per call), ni
+ *                           sha1_update: decomposed (reference)
+ *   -DBENCH_SHA1_ROLLING    sha1_transform: rolling
+ *   -DBENCH_SHA1_UPDATE_FAST  sha1_update: fast
+ *
+ * Each build checks its variant against the reference it includes,
+ * so only the default build prints the reference rows.
+ */
+
+#if defined(BENCH_SHA1_ROLLING)
+#include "../experiments/crypto-algorithms/sha1/sha1_rolling.c"
+#elif defined(BENCH_SHA1_UPDATE_FAST)
+#include "../experiments/crypto-algorithms/sha1/sha1_update_fast.c"
+#else
+#include "../experiments/crypto-algorithms/sha1/sha1_unrolled.c"
+#include "../experiments/crypto-algorithms/sha1/sha1_mb.h"
+#endif
+#include "bench.h"
+
+#define BENCH_SHA1_BLOCKS 64
+
+static BYTE sha1_buf[64 * BENCH_SHA1_BLOCKS];
+static SHA1_CTX sha1_ctx;
+
+#ifndef BENCH_SHA1_UPDATE_FAST
+typedef void (*sha1_transform_fn)(SHA1_CTX *, const BYTE *);
+
+static void run_transform(sha1_transform_fn f)
+{
+    int i;
+    for (i = 0; i < BENCH_SHA1_BLOCKS; i++)
+        f(&sha1_ctx, &sha1_buf[64 * i]);
+}
+
+// Hash every block of the buffer with f starting from sha1_init
+static void hash_blocks(sha1_transform_fn f, WORD out[5])
+{
+    sha1_init(&sha1_ctx);
+    run_transform(f);
+    memcpy(out, sha1_ctx.state, sizeof(sha1_ctx.state));
+}
+
+static void check_transform(const char *variant, sha1_transform_fn f)
+{
+    WORD ref[5], got[5];
+
+    hash_blocks(sha1_transform, ref);
+    hash_blocks(f, got);
+    if (memcmp(ref, got, sizeof(ref)) != 0)
+        bench_fail("sha1_transform", variant, "decomposed");
+}
+#endif
+
+#if defined(BENCH_SHA1_ROLLING)
+
+static void run_rolling(void *arg) { (void)arg; run_transform(sha1_transform_rolling); }
+
+static void bench_variants(void)
+{
+    check_transform("rolling", sha1_transform_rolling);
+    sha1_init(&sha1_ctx);
+    bench_run("sha1_transform", "rolling", "decomposed", sizeof(sha1_buf), run_rolling, NULL);
+}
+
+#elif defined(BENCH_SHA1_UPDATE_FAST)
+
+static void run_update_fast(void *arg)
+{
+    (void)arg;
+    sha1_update_fast(&sha1_ctx, sha1_buf, sizeof(sha1_buf));
+}
+
+static void bench_variants(void)
+{
+    SHA1_CTX ref;
+    size_t len;
+
+    // Odd lengths exercise the head/tail buffering, not just whole blocks
+    for (len = 0; len < sizeof(sha1_buf); len += 37) {
+        sha1_init(&ref);
+        sha1_init(&sha1_ctx);
+        sha1_update(&ref, sha1_buf, 5);
+        sha1_update_fast(&sha1_ctx, sha1_buf, 5);
+        sha1_update(&ref, sha1_buf, len);
+        sha1_update_fast(&sha1_ctx, sha1_buf, len);
+        if (memcmp(&ref, &sha1_ctx, sizeof(ref)) != 0)
+            bench_fail("sha1_update", "fast", "decomposed");
+    }
+    sha1_init(&sha1_ctx);
+    bench_run("sha1_update", "fast", "decomposed", sizeof(sha1_buf), run_update_fast, NULL);
+}
+
+#else
+
+static WORD mb_h[5][SHA1_MB_LANES];
+
+static void run_decomposed(void *arg) { (void)arg; run_transform(sha1_transform); }
+static void run_unrolled(void *arg) { (void)arg; run_transform(sha1_transform_unrolled); }
+
+static void run_update(void *arg)
+{
+    (void)arg;
+    sha1_update(&sha1_ctx, sha1_buf, sizeof(sha1_buf));
+}
+
+// SHA1_MB_LANES independent streams, one block of the buffer per lane
+static void run_mb(void *arg)
+{
+    const BYTE *data[SHA1_MB_LANES];
+    int i, l;
+
+    (void)arg;
+    for (i = 0; i < BENCH_SHA1_BLOCKS; i += SHA1_MB_LANES) {
+        for (l = 0; l < SHA1_MB_LANES; l++)
+            data[l] = &sha1_buf[64 * (i + l)];
+        sha1_mb_transform(mb_h, data, sha1_ctx.k);
+    }
+}
+
+static void check_mb(void)
+{
+    SHA1_CTX lane;
+    const BYTE *data[SHA1_MB_LANES];
+    int l, j;
+
+    sha1_init(&sha1_ctx);
+    for (l = 0; l < SHA1_MB_LANES; l++)
+        for (j = 0; j < 5; j++)
+            mb_h[j][l] = sha1_ctx.state[j];
+    for (l = 0; l < SHA1_MB_LANES; l++)
+        data[l] = &sha1_buf[64 * l];
+    sha1_mb_transform(mb_h, data, sha1_ctx.k);
+
+    for (l = 0; l < SHA1_MB_LANES; l++) {
+        sha1_init(&lane);
+        sha1_transform(&lane, &sha1_buf[64 * l]);
+        for (j = 0; j < 5; j++)
+            if (mb_h[j][l] != lane.state[j])
+                bench_fail("sha1_transform", "mb4", "decomposed");
+    }
+}
+
+#ifdef BENCH_SHANI
+static void run_ni(void *arg) { (void)arg; run_transform(sha1_transform_ni); }
+#endif
+
+static void bench_variants(void)
+{
+    check_transform("unrolled", sha1_transform_unrolled);
+    check_mb();
+
+    sha1_init(&sha1_ctx);
+    bench_run("sha1_transform", "decomposed", "decomposed", sizeof(sha1_buf), run_decomposed, NULL);
+    bench_run("sha1_transform", "unrolled", "decomposed", sizeof(sha1_buf), run_unrolled, NULL);
+    bench_run("sha1_transform", "mb4", "decomposed", sizeof(sha1_buf), run_mb, NULL);
+#ifdef BENCH_SHANI
+    if (__builtin_cpu_supports("sha")) {
+        check_transform("ni", sha1_transform_ni);
+        sha1_init(&sha1_ctx);
+        bench_run("sha1_transform", "ni", "decomposed", sizeof(sha1_buf), run_ni, NULL);
+    }
+#endif
+    sha1_init(&sha1_ctx);
+    bench_run("sha1_update", "decomposed", "decomposed", sizeof(sha1_buf), run_update, NULL);
+}
+
+#endif
+
+int main(void)
+{
+    int i;
+
+    srand(1);
+    for (i = 0; i < (int)sizeof(sha1_buf); i++)
+        sha1_buf[i] = (BYTE)rand();
+    bench_variants();
+    return 0;
+}
@@ -6,9 +6,110 @@
 CLANG ?= /opt/homebrew/opt/llvm@18/bin/clang
 SAW ?= $(ROOT)/tools/saw/bin/saw
 
+# llvm-dis from the same toolchain (clang-18 -> llvm-dis-18), for opt-report
+# and the function-level proof cache keys (scripts/bc-slice.py)
+LLVM_DIS ?= $(subst clang,llvm-dis,$(CLANG))
+export LLVM_DIS
+
+# Optimisation level of the bitcode under verification. The default O0
+# build writes x.bc next to the sources, as the SAW scripts always had it;
+# any other level builds into bc-$(OPT)/ alongside it, e.g.
+#   make verify OPT=O2 OPT_CFLAGS=-march=native
+# SAW scripts find the right files through SAW_BCDIR (scripts/prelude.saw).
+OPT ?= O0
+OPT_CFLAGS ?=
+BCDIR := $(if $(filter O0,$(OPT)),,bc-$(OPT)/)
+export SAW_BCDIR := $(BCDIR)
+# (created only in directories that hold SAW scripts)
+ifneq ($(BCDIR),)
+ifneq ($(wildcard *.saw),)
+$(shell mkdir -p $(BCDIR))
+endif
+endif
+
 # Clang flags for SAW compatibility
-CFLAGS := -emit-llvm -c -g -O0
+CFLAGS := -emit-llvm -c -g -$(OPT) $(OPT_CFLAGS)
+
+# Pre-flight check of optimised bitcode against what the SAW scripts expect
+OPT_REPORT = $(ROOT)/scripts/opt-report.sh
+
+# Proof stages run as separate SAW processes so make -jN can schedule them
+# (verify-1989, verify-encrypt-unint). A stage's stamp in $(PROOFS)/ means
+# its specs are proved; stages that assume them depend on that stamp.
+# Stamps are per OPT level, like the bitcode they were proved on.
+PROOFS := $(BCDIR).proofs
+SAW_STAGE = SAW=$(SAW) $(ROOT)/scripts/saw-stage.sh
+
+# Proof result cache, see scripts/saw-cache.sh: a script whose bitcode,
+# specs, includes and tool versions hash to a stored passing run is not
+# re-run. Verify recipes use $(SAW_RUN); make SAW_CACHE= disables it.
+SAW_CACHE ?= $(abspath $(ROOT))/.saw-cache
+export SAW_CACHE
+SAW_RUN = SAW=$(SAW) $(ROOT)/scripts/saw-cache.sh
+
+# Theorem store, see scripts/theorem-store.py: overrides proved with
+# export_verified are filed here when their script passes, and
+# import_verified in later scripts checks for them instead of re-proving.
+# make SAW_THEOREMS= turns the check off.
+SAW_THEOREMS ?= $(abspath $(ROOT))/.saw-theorems
+export SAW_THEOREMS
+
+# Output of every $(SAW_RUN), with the timing lines from scripts/prelude.saw,
+# one tree per OPT level; make verify-report summarises it
+SAW_LOG_DIR ?= $(abspath $(ROOT))/.saw-logs/$(OPT)
+export SAW_LOG_DIR
+export SAW_ROOT := $(abspath $(ROOT))
+
+# Solver race for scripts that use the portfolio tactic (scripts/prelude.saw,
+# scripts/saw-portfolio.sh): the winner is pinned in the directory's
+# solvers.pin, which later $(SAW_RUN)s of the script follow. abc is left
+# out: it cannot keep functions uninterpreted, so it can only win a script
+# whose portfolio calls all pass [] (add it with SAW_PORTFOLIO="... abc")
+SAW_PORTFOLIO ?= z3 yices cvc5
+export SAW_PORTFOLIO
+SAW_RACE = SAW=$(SAW) $(ROOT)/scripts/saw-portfolio.sh
 
 # Cryptol specs path
 CRYPTOLPATH := $(ROOT)/specs/cryptol-specs
 export CRYPTOLPATH
+
+# Memory cap for every $(SAW_RUN) / $(SAW_STAGE), in MiB: SAW and its
+# solvers together. A run over it is killed and reported as MEMCAP with the
+# proof call it was in (scripts/saw-cache.sh, exit status 3). Empty: no cap
+SAW_MEM_LIMIT ?=
+export SAW_MEM_LIMIT
+
+# Proof cost tiers. Every experiment Makefile sorts its verify targets by
+# the most expensive SAW process they start:
+#   VERIFY_LEAF          small functions or short compositions: seconds to
+#                        a few minutes, little memory
+#   VERIFY_COMPOSITIONAL whole functions from verified or assumed overrides,
+#                        each process bounded by its largest lemma
+#   VERIFY_MONOLITHIC    large functions symbolically executed in one go:
+#                        slow and memory-hungry
+# and lists in VERIFY_CI_SUBSET the compositional targets whose run time is
+# known (stated beside the list) and fits the 60-minute pull-request job
+# together with the leaf tier.
+# make verify-budget runs the tiers up to VERIFY_BUDGET (leaf, ci =
+# leaf + VERIFY_CI_SUBSET, compositional or monolithic); verify-ci is the
+# same with CI_BUDGET under CI_MEM_LIMIT. The scheduled CI job runs
+# CI_BUDGET=compositional without the 60-minute cap and keeps its
+# verify-report, the timing a target needs before it joins the subset.
+VERIFY_BUDGET ?= compositional
+CI_BUDGET ?= ci
+CI_MEM_LIMIT ?= 6144
+ifeq ($(filter leaf ci compositional monolithic,$(VERIFY_BUDGET)),)
+$(error VERIFY_BUDGET=$(VERIFY_BUDGET): expected leaf, ci, compositional or monolithic)
+endif
+budget_targets = $(VERIFY_LEAF) \
+    $(if $(filter ci,$(VERIFY_BUDGET)),$(VERIFY_CI_SUBSET)) \
+    $(if $(filter compositional monolithic,$(VERIFY_BUDGET)),$(VERIFY_COMPOSITIONAL)) \
+    $(if $(filter monolithic,$(VERIFY_BUDGET)),$(VERIFY_MONOLITHIC))
+VERIFY_CI = $(MAKE) verify-budget VERIFY_BUDGET=$(CI_BUDGET) SAW_MEM_LIMIT=$(CI_MEM_LIMIT)
+
+# $(call saw_or_fallback,script.saw,target): run a monolithic script; if it
+# hits SAW_MEM_LIMIT, make the target that proves the same specs as
+# compositional stages instead
+saw_or_fallback = $(SAW_RUN) $(1) || { rc=$$?; [ $$rc -eq 3 ] || exit $$rc; \
+    echo "$(1) over SAW_MEM_LIMIT=$(SAW_MEM_LIMIT) MiB: falling back to make $(2)"; \
+    $(MAKE) $(2); }
@@ -0,0 +1,359 @@
+/*********************************************************************
+* Filename:   aes_bitsliced.c
+* Purpose:    Bitsliced constant-time AES-128, 8 blocks in parallel
+*
+* Key insight: instead of indexing a table with secret bytes, transpose
+* 8 blocks so that each machine word holds ONE bit position of many
+* bytes. The S-box then becomes a fixed boolean circuit evaluated on
+* 32 bytes at once, with no secret-dependent loads or branches.
+*
+* Layout: WORD s[4][8] holds 8 AES states (lanes 0..7).
+*   s[r][i] bit (8*c + lane) = bit i of state[r][c] of block `lane`
+* so each word is one bit-plane of one state row. With this layout
+*   - ShiftRows is a rotate of each plane by 8*r bits
+*   - MixColumns is XOR of whole rows plus a bit-plane xtime
+*   - SubBytes is the S-box circuit applied to each row's 8 planes
+* Packing 8 blocks into planes (and back) is sixteen 8x8 bit-matrix
+* transposes, three swapmove steps each.
+*
+* The round functions are noinline so they can be verified lane-wise
+* against the Cryptol primitives (aes_verify_bitsliced.saw) and reused
+* as overrides, exactly like the B-Con primitives in
+* aes_verify_encrypt_unint.saw.
+*********************************************************************/
+
+#include <stdint.h>
+#include "../repo/aes.h"
+
+#define BS_LANES 8
+
+/*
+ * =============================================================================
+ * S-box circuit: Boyar-Peralta, 115 gates (32 AND, 83 XOR/XNOR), depth 16
+ * J. Boyar, R. Peralta, "A depth-16 circuit for the AES S-box" (2012).
+ * A top linear layer maps the input bits into the GF(2^4) tower field,
+ * the middle section inverts there, a bottom linear layer applies the
+ * inverse basis change and the AES affine map. The circuit numbers bits
+ * MSB first: u0 = x[7] .. u7 = x[0], and s0 lands in x[7].
+ * =============================================================================
+ */
+__attribute__((noinline))
+void bs_sbox(WORD x[8]) {
+    WORD u0, u1, u2, u3, u4, u5, u6, u7;
+    WORD y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11, y12, y13, y14, y15;
+    WORD y16, y17, y18, y19, y20, y21;
+    WORD t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14;
+    WORD t15, t16, t17, t18, t19, t20, t21, t22, t23, t24, t25, t26, t27;
+    WORD t28, t29, t30, t31, t32, t33, t34, t35, t36, t37, t38, t39, t40;
+    WORD t41, t42, t43, t44, t45, t46, t47, t48, t49, t50, t51, t52, t53;
+    WORD t54, t55, t56, t57, t58, t59, t60, t61, t62, t63, t64, t65, t66, t67;
+    WORD z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10, z11, z12, z13, z14;
+    WORD z15, z16, z17;
+    WORD s0, s1, s2, s3, s4, s5, s6, s7;
+
+    u0 = x[7]; u1 = x[6]; u2 = x[5]; u3 = x[4];
+    u4 = x[3]; u5 = x[2]; u6 = x[1]; u7 = x[0];
+
+    // Top linear layer
+    y14 = u3 ^ u5;
+    y13 = u0 ^ u6;
+    y9 = u0 ^ u3;
+    y8 = u0 ^ u5;
+    t0 = u1 ^ u2;
+    y1 = t0 ^ u7;
+    y4 = y1 ^ u3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ u0;
+    y5 = y1 ^ u6;
+    y3 = y5 ^ y8;
+    t1 = u4 ^ y12;
+    y15 = t1 ^ u5;
+    y20 = t1 ^ u1;
+    y6 = y15 ^ u7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = u7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = u0 ^ y16;
+
+    // Nonlinear middle: inversion in the tower field
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & u7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & u7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    // Bottom linear layer (affine constant 0x63 folded into the XNORs)
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    x[7] = s0; x[6] = s1; x[5] = s2; x[4] = s3;
+    x[3] = s4; x[2] = s5; x[1] = s6; x[0] = s7;
+}
+
+// Single-byte view of the circuit (lane 0 of a one-byte batch).
+// Verified against the Cryptol SBox for all 256 inputs; same spec as
+// sbox_lookup in aes_sbox_decomposed.c.
+__attribute__((noinline))
+BYTE bs_sbox_byte(BYTE b) {
+    WORD x[8];
+    BYTE out = 0;
+    int i;
+
+    for (i = 0; i < 8; i++)
+        x[i] = (b >> i) & 1;
+    bs_sbox(x);
+    for (i = 0; i < 8; i++)
+        out |= (BYTE)((x[i] & 1) << i);
+    return out;
+}
+
+/*
+ * =============================================================================
+ * Round functions on the bitsliced state
+ * =============================================================================
+ */
+
+__attribute__((noinline))
+void bs_sub_bytes(WORD s[4][8]) {
+    bs_sbox(s[0]);
+    bs_sbox(s[1]);
+    bs_sbox(s[2]);
+    bs_sbox(s[3]);
+}
+
+// Row r moves left by r columns: new column c comes from column c+r,
+// i.e. each 8-bit column group rotates right by 8*r bit positions.
+__attribute__((noinline))
+void bs_shift_rows(WORD s[4][8]) {
+    int r, i;
+
+    for (r = 1; r < 4; r++)
+        for (i = 0; i < 8; i++)
+            s[r][i] = (s[r][i] >> (8 * r)) | (s[r][i] << (32 - 8 * r));
+}
+
+// xtime on bit-planes: multiply every lane byte by x
+static void bs_xtime(const WORD a[8], WORD out[8]) {
+    out[0] = a[7];
+    out[1] = a[0] ^ a[7];
+    out[2] = a[1];
+    out[3] = a[2] ^ a[7];
+    out[4] = a[3] ^ a[7];
+    out[5] = a[4];
+    out[6] = a[5];
+    out[7] = a[6];
+}
+
+// out_r = 2*a_r ^ 3*a_(r+1) ^ a_(r+2) ^ a_(r+3)
+//       = xtime(a_r ^ a_(r+1)) ^ a_(r+1) ^ a_(r+2) ^ a_(r+3)
+__attribute__((noinline))
+void bs_mix_columns(WORD s[4][8]) {
+    WORD a[4][8], t[8], xt[8];
+    int r, i;
+
+    for (r = 0; r < 4; r++)
+        for (i = 0; i < 8; i++)
+            a[r][i] = s[r][i];
+
+    for (r = 0; r < 4; r++) {
+        for (i = 0; i < 8; i++)
+            t[i] = a[r][i] ^ a[(r + 1) & 3][i];
+        bs_xtime(t, xt);
+        for (i = 0; i < 8; i++)
+            s[r][i] = xt[i] ^ a[(r + 1) & 3][i] ^ a[(r + 2) & 3][i] ^ a[(r + 3) & 3][i];
+    }
+}
+
+// XOR one B-Con round key (4 big-endian column words) into every lane.
+// Key bit -> all-ones/all-zeros lane mask without branching on the key.
+__attribute__((noinline))
+void bs_add_round_key(WORD s[4][8], const WORD w[]) {
+    int r, i, c;
+    WORD mask;
+
+    for (r = 0; r < 4; r++)
+        for (i = 0; i < 8; i++) {
+            mask = 0;
+            for (c = 0; c < 4; c++)
+                mask |= ((WORD)0 - ((w[c] >> (24 - 8 * r + i)) & 1)) & ((WORD)0xFF << (8 * c));
+            s[r][i] ^= mask;
+        }
+}
+
+/*
+ * =============================================================================
+ * Transposition between 8 byte-oriented blocks and bit-planes
+ * Block byte order is the B-Con/FIPS order: in[16*lane + 4*c + r] = state[r][c]
+ * =============================================================================
+ */
+
+// Transpose an 8x8 bit matrix held one row per byte: bit j of byte i
+// moves to bit i of byte j. Three swapmove steps exchange the
+// off-diagonal 1x1, 2x2 and 4x4 blocks.
+static uint64_t bs_transpose8(uint64_t x) {
+    uint64_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x ^= t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x ^= t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x ^= t ^ (t << 28);
+    return x;
+}
+
+// For each state byte (r, c) the 8 lanes' bytes form one 8x8 bit matrix
+// (byte lane = the byte of block `lane`); transposed, byte i holds bit i
+// of every lane, which is column group c of plane s[r][i].
+// Verified against statesToBs (aes_verify_bitsliced.saw).
+__attribute__((noinline))
+void bs_pack(const BYTE in[], WORD s[4][8]) {
+    uint64_t x;
+    int r, c, i, lane;
+
+    for (r = 0; r < 4; r++)
+        for (i = 0; i < 8; i++)
+            s[r][i] = 0;
+    for (r = 0; r < 4; r++)
+        for (c = 0; c < 4; c++) {
+            x = 0;
+            for (lane = 0; lane < BS_LANES; lane++)
+                x |= (uint64_t)in[16 * lane + 4 * c + r] << (8 * lane);
+            x = bs_transpose8(x);
+            for (i = 0; i < 8; i++)
+                s[r][i] |= (WORD)((x >> (8 * i)) & 0xFF) << (8 * c);
+        }
+}
+
+// Inverse of bs_pack: the transpose is its own inverse
+__attribute__((noinline))
+void bs_unpack(WORD s[4][8], BYTE out[]) {
+    uint64_t x;
+    int r, c, i, lane;
+
+    for (r = 0; r < 4; r++)
+        for (c = 0; c < 4; c++) {
+            x = 0;
+            for (i = 0; i < 8; i++)
+                x |= (uint64_t)((s[r][i] >> (8 * c)) & 0xFF) << (8 * i);
+            x = bs_transpose8(x);
+            for (lane = 0; lane < BS_LANES; lane++)
+                out[16 * lane + 4 * c + r] = (BYTE)(x >> (8 * lane));
+        }
+}
+
+/*
+ * =============================================================================
+ * AES-128 encryption of 8 blocks (128 bytes) with a B-Con key schedule
+ * Equivalent to calling aes_encrypt(in + 16*i, out + 16*i, key, 128)
+ * for i = 0..7.
+ * =============================================================================
+ */
+void aes128_encrypt_bitsliced(const BYTE in[], BYTE out[], const WORD key[]) {
+    WORD s[4][8];
+    int round;
+
+    bs_pack(in, s);
+    bs_add_round_key(s, &key[0]);
+    for (round = 1; round < 10; round++) {
+        bs_sub_bytes(s);
+        bs_shift_rows(s);
+        bs_mix_columns(s);
+        bs_add_round_key(s, &key[4 * round]);
+    }
+    bs_sub_bytes(s);
+    bs_shift_rows(s);
+    bs_add_round_key(s, &key[40]);
+    bs_unpack(s, out);
+}
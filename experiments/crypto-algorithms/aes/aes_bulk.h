@@ -0,0 +1,41 @@
+/*********************************************************************
+* Filename:   aes_bulk.h
+* Purpose:    Multi-block AES-ECB / AES-CTR over block ranges
+*
+* Every function works on a RANGE of whole 16-byte blocks, so a buffer
+* can be split into disjoint ranges and handed to independent workers
+* (aes_bulk_parallel.c). A CTR range starting at block `first_block`
+* uses counter iv + first_block, so the ranges need no shared state.
+*********************************************************************/
+
+#ifndef AES_BULK_H
+#define AES_BULK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../repo/aes.h"
+
+// Upper bound on worker threads used by the parallel driver
+#define AES_BULK_MAX_THREADS 16
+
+// ctr = ctr + n, as a 128-bit big-endian integer (wraps mod 2^128)
+void aes_bulk_ctr_add(BYTE ctr[], uint64_t n);
+
+// out[i] = E(in[i]) for blocks i = 0 .. nblocks-1
+void aes_ecb_encrypt_blocks(const BYTE in[], BYTE out[], size_t nblocks,
+                            const WORD key[], int keysize);
+
+// out[i] = in[i] ^ E(iv + first_block + i) for blocks i = 0 .. nblocks-1
+// (encryption and decryption are the same operation)
+void aes_ctr_crypt_blocks(const BYTE in[], BYTE out[], size_t nblocks,
+                          const WORD key[], int keysize,
+                          const BYTE iv[], uint64_t first_block);
+
+// Same results as the functions above, work split over nthreads workers
+void aes_ecb_encrypt_parallel(const BYTE in[], BYTE out[], size_t nblocks,
+                              const WORD key[], int keysize, int nthreads);
+void aes_ctr_crypt_parallel(const BYTE in[], BYTE out[], size_t nblocks,
+                            const WORD key[], int keysize,
+                            const BYTE iv[], int nthreads);
+
+#endif   // AES_BULK_H
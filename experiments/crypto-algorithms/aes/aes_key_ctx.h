@@ -0,0 +1,35 @@
+/*********************************************************************
+* Filename:   aes_key_ctx.h
+* Purpose:    Reusable AES key context (encryption + decryption schedule)
+*
+* Callers treat aes_key_ctx as opaque: initialise it once per key with
+* aes_key_ctx_init and pass it to aes_ctx_encrypt/aes_ctx_decrypt for
+* every block. The layout is public only so the context can live on the
+* stack or inside a session object without allocation.
+*********************************************************************/
+
+#ifndef AES_KEY_CTX_H
+#define AES_KEY_CTX_H
+
+#include "../repo/aes.h"
+
+// Large enough for AES-256: 4 * (14 + 1) words
+#define AES_KEY_CTX_WORDS 60
+
+// Each schedule starts on its own cache line
+#define AES_KEY_CTX_ALIGN 64
+
+typedef struct {
+	WORD enc[AES_KEY_CTX_WORDS] __attribute__((aligned(AES_KEY_CTX_ALIGN)));
+	// Equivalent-inverse-cipher schedule: InvMixColumns already applied
+	// to round keys 1 .. rounds-1 (FIPS-197 Section 5.3.5)
+	WORD dec[AES_KEY_CTX_WORDS] __attribute__((aligned(AES_KEY_CTX_ALIGN)));
+	int keysize;
+	int rounds;
+} aes_key_ctx;
+
+void aes_key_ctx_init(aes_key_ctx *ctx, const BYTE key[], int keysize);
+void aes_ctx_encrypt(const aes_key_ctx *ctx, const BYTE in[], BYTE out[]);
+void aes_ctx_decrypt(const aes_key_ctx *ctx, const BYTE in[], BYTE out[]);
+
+#endif   // AES_KEY_CTX_H
@@ -0,0 +1,185 @@
+/*********************************************************************
+* Filename:   aes_ni.c
+* Purpose:    AES-NI (AESENC/AESDEC/AESKEYGENASSIST) AES-128 path
+*
+* Key insight: SAW cannot symbolically execute the x86 AES instructions,
+* but each one is exactly a composition of the Cryptol primitives:
+*
+*   AESENC      s k = AddRoundKey k (MixColumns (ShiftRows (SubBytes s)))
+*   AESENCLAST  s k = AddRoundKey k (ShiftRows (SubBytes s))
+*   AESDEC      s k = AddRoundKey k (InvMixColumns (InvSubBytes (InvShiftRows s)))
+*   AESDECLAST  s k = AddRoundKey k (InvSubBytes (InvShiftRows s))
+*   AESIMC      s   = InvMixColumns s
+*
+* Every instruction is wrapped in its own noinline function, and
+* aes_verify_aesni.saw assumes those wrappers' specs (the modelled ISA
+* semantics) and verifies everything else - key expansion, whitening,
+* round sequencing, decryption schedule - against the same unroll
+* lemmas used for the B-Con code in aes_verify_symbolic_key.saw.
+*
+* Round keys are kept in AES-NI byte order (FIPS-197 column-major, the
+* same order as in[]/out[]), 11 x 16 = 176 bytes for AES-128.
+* aesni_schedule_from_words converts a B-Con aes_key_setup schedule.
+*
+* Build: needs an x86-64 target with -maes (see Makefile).
+*********************************************************************/
+
+#include <wmmintrin.h>
+#include "../repo/aes.h"
+
+#define AESNI_ROUNDS_128 10
+
+/*
+ * =============================================================================
+ * Instruction wrappers (assumed in aes_verify_aesni.saw)
+ * =============================================================================
+ */
+
+__attribute__((noinline))
+void aesni_enc_round(BYTE state[16], const BYTE rk[16]) {
+    __m128i s = _mm_loadu_si128((const __m128i *)state);
+    __m128i k = _mm_loadu_si128((const __m128i *)rk);
+    _mm_storeu_si128((__m128i *)state, _mm_aesenc_si128(s, k));
+}
+
+__attribute__((noinline))
+void aesni_enc_last(BYTE state[16], const BYTE rk[16]) {
+    __m128i s = _mm_loadu_si128((const __m128i *)state);
+    __m128i k = _mm_loadu_si128((const __m128i *)rk);
+    _mm_storeu_si128((__m128i *)state, _mm_aesenclast_si128(s, k));
+}
+
+__attribute__((noinline))
+void aesni_dec_round(BYTE state[16], const BYTE rk[16]) {
+    __m128i s = _mm_loadu_si128((const __m128i *)state);
+    __m128i k = _mm_loadu_si128((const __m128i *)rk);
+    _mm_storeu_si128((__m128i *)state, _mm_aesdec_si128(s, k));
+}
+
+__attribute__((noinline))
+void aesni_dec_last(BYTE state[16], const BYTE rk[16]) {
+    __m128i s = _mm_loadu_si128((const __m128i *)state);
+    __m128i k = _mm_loadu_si128((const __m128i *)rk);
+    _mm_storeu_si128((__m128i *)state, _mm_aesdeclast_si128(s, k));
+}
+
+__attribute__((noinline))
+void aesni_inv_mix_columns(BYTE out[16], const BYTE in[16]) {
+    __m128i s = _mm_loadu_si128((const __m128i *)in);
+    _mm_storeu_si128((__m128i *)out, _mm_aesimc_si128(s));
+}
+
+// AESKEYGENASSIST needs an immediate, so run it with rcon = 0 and XOR the
+// round constant into the low byte of dwords 1 and 3 (where the ISA puts it).
+//   out dword 0 = SubWord(X1)   out dword 1 = RotWord(SubWord(X1)) ^ rcon
+//   out dword 2 = SubWord(X3)   out dword 3 = RotWord(SubWord(X3)) ^ rcon
+// with X1 = in dword 1, X3 = in dword 3.
+__attribute__((noinline))
+void aesni_keygen_assist(BYTE out[16], const BYTE in[16], BYTE rcon) {
+    __m128i s = _mm_loadu_si128((const __m128i *)in);
+    __m128i r = _mm_aeskeygenassist_si128(s, 0x00);
+    r = _mm_xor_si128(r, _mm_set_epi32(rcon, 0, rcon, 0));
+    _mm_storeu_si128((__m128i *)out, r);
+}
+
+/*
+ * =============================================================================
+ * Plain C glue (verified, not assumed)
+ * =============================================================================
+ */
+
+// Initial whitening: AddRoundKey on the byte-ordered state
+__attribute__((noinline))
+void aesni_xor_block(BYTE state[16], const BYTE rk[16]) {
+    int i;
+
+    for (i = 0; i < 16; i++)
+        state[i] ^= rk[i];
+}
+
+// AES-128 key expansion driven by AESKEYGENASSIST.
+// rk_i word 0 = rk_(i-1) word 0 ^ RotWord(SubWord(rk_(i-1) word 3)) ^ rcon,
+// words 1..3 chain by XOR with the word before them.
+void aes128_key_setup_aesni(const BYTE key[16], BYTE rk[176]) {
+    static const BYTE rcon[AESNI_ROUNDS_128] = {
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+    };
+    BYTE assist[16];
+    int i, j;
+
+    for (j = 0; j < 16; j++)
+        rk[j] = key[j];
+
+    for (i = 1; i <= AESNI_ROUNDS_128; i++) {
+        aesni_keygen_assist(assist, &rk[16 * (i - 1)], rcon[i - 1]);
+        for (j = 0; j < 4; j++)
+            rk[16 * i + j] = rk[16 * (i - 1) + j] ^ assist[12 + j];
+        for (j = 4; j < 16; j++)
+            rk[16 * i + j] = rk[16 * (i - 1) + j] ^ rk[16 * i + j - 4];
+    }
+}
+
+// Convert a B-Con schedule (big-endian column words) to AES-NI byte order
+void aesni_schedule_from_words(const WORD w[], BYTE rk[], int nwords) {
+    int i;
+
+    for (i = 0; i < nwords; i++) {
+        rk[4 * i]     = (BYTE)(w[i] >> 24);
+        rk[4 * i + 1] = (BYTE)(w[i] >> 16);
+        rk[4 * i + 2] = (BYTE)(w[i] >> 8);
+        rk[4 * i + 3] = (BYTE)(w[i]);
+    }
+}
+
+// Equivalent-inverse-cipher schedule for AESDEC: dk_0 = rk_0, dk_10 = rk_10,
+// dk_i = InvMixColumns(rk_i) for the middle rounds.
+void aes128_decrypt_key_aesni(const BYTE rk[176], BYTE dk[176]) {
+    int i, j;
+
+    for (j = 0; j < 16; j++) {
+        dk[j] = rk[j];
+        dk[16 * AESNI_ROUNDS_128 + j] = rk[16 * AESNI_ROUNDS_128 + j];
+    }
+    for (i = 1; i < AESNI_ROUNDS_128; i++)
+        aesni_inv_mix_columns(&dk[16 * i], &rk[16 * i]);
+}
+
+/*
+ * =============================================================================
+ * AES-128 block encryption/decryption
+ * Same in/out byte order as aes_encrypt/aes_decrypt.
+ * =============================================================================
+ */
+
+void aes128_encrypt_aesni(const BYTE in[16], BYTE out[16], const BYTE rk[176]) {
+    BYTE state[16];
+    int i;
+
+    for (i = 0; i < 16; i++)
+        state[i] = in[i];
+
+    aesni_xor_block(state, &rk[0]);
+    for (i = 1; i < AESNI_ROUNDS_128; i++)
+        aesni_enc_round(state, &rk[16 * i]);
+    aesni_enc_last(state, &rk[16 * AESNI_ROUNDS_128]);
+
+    for (i = 0; i < 16; i++)
+        out[i] = state[i];
+}
+
+// dk must come from aes128_decrypt_key_aesni
+void aes128_decrypt_aesni(const BYTE in[16], BYTE out[16], const BYTE dk[176]) {
+    BYTE state[16];
+    int i;
+
+    for (i = 0; i < 16; i++)
+        state[i] = in[i];
+
+    aesni_xor_block(state, &dk[16 * AESNI_ROUNDS_128]);
+    for (i = AESNI_ROUNDS_128 - 1; i >= 1; i--)
+        aesni_dec_round(state, &dk[16 * i]);
+    aesni_dec_last(state, &dk[0]);
+
+    for (i = 0; i < 16; i++)
+        out[i] = state[i];
+}
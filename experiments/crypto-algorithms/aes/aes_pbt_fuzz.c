@@ -0,0 +1,517 @@
+/*
+ * Native fuzzer for the AES PBT harness: Cryptol vectors, then C-only
+ * properties
+ *
+ * aes_pbt.saw checks the pbt_* wrappers against aes_pbt.cry through
+ * llvm_extract and quickcheck, so every sample is evaluated in SAWCore
+ * (about ten minutes for its 641 random tests). This file builds the
+ * same wrappers natively and
+ *
+ *   1. replays the Cryptol test vectors written by aes_pbt_vectors.saw:
+ *      every row's outputs must be the reference's, bit for bit
+ *   2. streams random inputs through them on every core for a fixed
+ *      time, checking in C the properties aes_pbt.cry states about the
+ *      reference, with no Cryptol in the loop: the S-box and state inverses, SubBytes/SubWord as the
+ *      byte-wise S-box, linearity of ShiftRows/MixColumns, AddRoundKey as
+ *      XOR, the key schedule recurrence, encrypt/decrypt round trips for
+ *      all three key sizes and batch == single. One input in EDGE_ODDS is
+ *      an edge value (0, ~0, one bit set or clear, one repeated byte).
+ *
+ * Only phase 1 is differential: it ties the C to Cryptol on fixed points.
+ * Phase 2 checks the C wrappers against each other (an inverse undoes
+ * its function, decrypt undoes encrypt, a batch equals its single
+ * blocks), so a bug that both sides of a property share, such as two
+ * S-box entries swapped in SBox and InvSBox alike, passes it. It runs
+ * millions of cases per minute as a quick filter before the proofs, not
+ * a proof and not a comparison with the reference.
+ *
+ * Usage: aes_pbt_fuzz [-s seconds] [-j threads] [-r seed] [vectors.txt]
+ *   -j 0 (default) starts one thread per online CPU. Without a vectors
+ *   file only phase 2 runs.
+ * Run: make fuzz
+ */
+
+#include "aes_pbt_harness.c"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_ARGS 8
+#define EDGE_ODDS 16        // one input in EDGE_ODDS is an edge value
+#define MAX_REPORTS 10      // failures printed in full, over all threads
+
+/*
+ * =============================================================================
+ * Phase 1: Cryptol vectors
+ * A row is "<wrapper> <inputs> <outputs>", all decimal uint64 (see
+ * aes_pbt_vectors.saw); the table gives each wrapper's input/output count.
+ * =============================================================================
+ */
+
+typedef void (*vec_fn)(const uint64_t a[], uint64_t r[]);
+
+struct vec_entry {
+    const char *name;
+    int nin, nout;
+    vec_fn run;
+    unsigned long rows;
+};
+
+#define VEC_STATE(f) \
+    static void vec_##f(const uint64_t a[], uint64_t r[]) { \
+        r[0] = pbt_##f##_lo(a[0], a[1]); \
+        r[1] = pbt_##f##_hi(a[0], a[1]); \
+    }
+
+VEC_STATE(SubBytes)
+VEC_STATE(InvSubBytes)
+VEC_STATE(ShiftRows)
+VEC_STATE(InvShiftRows)
+VEC_STATE(MixColumns)
+VEC_STATE(InvMixColumns)
+
+#define VEC_CIPHER128(f) \
+    static void vec_##f(const uint64_t a[], uint64_t r[]) { \
+        r[0] = pbt_##f##_lo(a[0], a[1], a[2], a[3]); \
+        r[1] = pbt_##f##_hi(a[0], a[1], a[2], a[3]); \
+    }
+
+VEC_CIPHER128(aes_encrypt)
+VEC_CIPHER128(aes_decrypt)
+
+#define VEC_CIPHER192(f) \
+    static void vec_##f(const uint64_t a[], uint64_t r[]) { \
+        r[0] = pbt_##f##_lo(a[0], a[1], a[2], a[3], a[4]); \
+        r[1] = pbt_##f##_hi(a[0], a[1], a[2], a[3], a[4]); \
+    }
+
+VEC_CIPHER192(aes_encrypt_192)
+VEC_CIPHER192(aes_decrypt_192)
+
+#define VEC_CIPHER256(f) \
+    static void vec_##f(const uint64_t a[], uint64_t r[]) { \
+        r[0] = pbt_##f##_lo(a[0], a[1], a[2], a[3], a[4], a[5]); \
+        r[1] = pbt_##f##_hi(a[0], a[1], a[2], a[3], a[4], a[5]); \
+    }
+
+VEC_CIPHER256(aes_encrypt_256)
+VEC_CIPHER256(aes_decrypt_256)
+
+static void vec_SBox(const uint64_t a[], uint64_t r[]) { r[0] = pbt_SBox((uint8_t)a[0]); }
+static void vec_InvSBox(const uint64_t a[], uint64_t r[]) { r[0] = pbt_InvSBox((uint8_t)a[0]); }
+static void vec_SubWord(const uint64_t a[], uint64_t r[]) { r[0] = pbt_SubWord((uint32_t)a[0]); }
+
+static void vec_AddRoundKey(const uint64_t a[], uint64_t r[]) {
+    r[0] = pbt_AddRoundKey_lo(a[0], a[1], a[2], a[3]);
+    r[1] = pbt_AddRoundKey_hi(a[0], a[1], a[2], a[3]);
+}
+
+static void vec_KeyExpansionStep(const uint64_t a[], uint64_t r[]) {
+    r[0] = pbt_KeyExpansionStep((uint32_t)a[0], (uint32_t)a[1], (uint32_t)a[2]);
+}
+
+static void vec_KeyExpansionStepSimple(const uint64_t a[], uint64_t r[]) {
+    r[0] = pbt_KeyExpansionStepSimple((uint32_t)a[0], (uint32_t)a[1]);
+}
+
+static void vec_KeyScheduleWord(const uint64_t a[], uint64_t r[]) {
+    r[0] = pbt_KeyScheduleWord(a[0], a[1], (uint32_t)a[2]);
+}
+
+static void vec_RoundKey(const uint64_t a[], uint64_t r[]) {
+    r[0] = pbt_RoundKey_lo(a[0], a[1], (uint32_t)a[2]);
+    r[1] = pbt_RoundKey_hi(a[0], a[1], (uint32_t)a[2]);
+}
+
+static void vec_RoundKey_192(const uint64_t a[], uint64_t r[]) {
+    r[0] = pbt_RoundKey_192_lo(a[0], a[1], a[2], (uint32_t)a[3]);
+    r[1] = pbt_RoundKey_192_hi(a[0], a[1], a[2], (uint32_t)a[3]);
+}
+
+static void vec_RoundKey_256(const uint64_t a[], uint64_t r[]) {
+    r[0] = pbt_RoundKey_256_lo(a[0], a[1], a[2], a[3], (uint32_t)a[4]);
+    r[1] = pbt_RoundKey_256_hi(a[0], a[1], a[2], a[3], (uint32_t)a[4]);
+}
+
+static struct vec_entry vec_table[] = {
+    { "SBox", 1, 1, vec_SBox, 0 },
+    { "InvSBox", 1, 1, vec_InvSBox, 0 },
+    { "SubWord", 1, 1, vec_SubWord, 0 },
+    { "SubBytes", 2, 2, vec_SubBytes, 0 },
+    { "InvSubBytes", 2, 2, vec_InvSubBytes, 0 },
+    { "ShiftRows", 2, 2, vec_ShiftRows, 0 },
+    { "InvShiftRows", 2, 2, vec_InvShiftRows, 0 },
+    { "MixColumns", 2, 2, vec_MixColumns, 0 },
+    { "InvMixColumns", 2, 2, vec_InvMixColumns, 0 },
+    { "AddRoundKey", 4, 2, vec_AddRoundKey, 0 },
+    { "KeyExpansionStep", 3, 1, vec_KeyExpansionStep, 0 },
+    { "KeyExpansionStepSimple", 2, 1, vec_KeyExpansionStepSimple, 0 },
+    { "KeyScheduleWord", 3, 1, vec_KeyScheduleWord, 0 },
+    { "RoundKey", 3, 2, vec_RoundKey, 0 },
+    { "RoundKey_192", 4, 2, vec_RoundKey_192, 0 },
+    { "RoundKey_256", 5, 2, vec_RoundKey_256, 0 },
+    { "aes_encrypt", 4, 2, vec_aes_encrypt, 0 },
+    { "aes_decrypt", 4, 2, vec_aes_decrypt, 0 },
+    { "aes_encrypt_192", 5, 2, vec_aes_encrypt_192, 0 },
+    { "aes_decrypt_192", 5, 2, vec_aes_decrypt_192, 0 },
+    { "aes_encrypt_256", 6, 2, vec_aes_encrypt_256, 0 },
+    { "aes_decrypt_256", 6, 2, vec_aes_decrypt_256, 0 },
+};
+
+#define NVEC (sizeof(vec_table) / sizeof(vec_table[0]))
+
+// Returns the number of failed rows, or -1 if the file cannot be used
+static long replay_vectors(const char *path) {
+    char line[1024], *tok, *end;
+    uint64_t v[2 * MAX_ARGS], r[MAX_ARGS];
+    unsigned long lineno = 0, rows = 0;
+    long failures = 0;
+    size_t e;
+    int i;
+    FILE *f = fopen(path, "r");
+
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        tok = strtok(line, " \n");
+        if (!tok)
+            continue;
+        for (e = 0; e < NVEC && strcmp(vec_table[e].name, tok) != 0; e++)
+            ;
+        if (e == NVEC) {
+            fprintf(stderr, "%s:%lu: no wrapper for vectors of %s\n", path, lineno, tok);
+            fclose(f);
+            return -1;
+        }
+        for (i = 0; i < vec_table[e].nin + vec_table[e].nout; i++) {
+            tok = strtok(NULL, " \n");
+            if (!tok)
+                break;
+            v[i] = strtoull(tok, &end, 10);
+            if (*end)
+                break;
+        }
+        if (i != vec_table[e].nin + vec_table[e].nout || strtok(NULL, " \n")) {
+            fprintf(stderr, "%s:%lu: expected %d values for %s\n", path, lineno,
+                    vec_table[e].nin + vec_table[e].nout, vec_table[e].name);
+            fclose(f);
+            return -1;
+        }
+        vec_table[e].run(v, r);
+        vec_table[e].rows++;
+        rows++;
+        if (memcmp(r, &v[vec_table[e].nin], vec_table[e].nout * sizeof(uint64_t)) != 0) {
+            if (failures < MAX_REPORTS) {
+                printf("  MISMATCH %s:%lu %s:", path, lineno, vec_table[e].name);
+                for (i = 0; i < vec_table[e].nout; i++)
+                    printf(" 0x%016llx (Cryptol 0x%016llx)", (unsigned long long)r[i],
+                           (unsigned long long)v[vec_table[e].nin + i]);
+                printf("\n");
+            }
+            failures++;
+        }
+    }
+    fclose(f);
+    if (rows == 0) {
+        fprintf(stderr, "%s: no vectors\n", path);
+        return -1;
+    }
+    for (e = 0; e < NVEC; e++)
+        if (vec_table[e].rows == 0)
+            printf("  (no vectors for %s)\n", vec_table[e].name);
+    printf("vectors: %lu rows from Cryptol, %ld mismatches\n", rows, failures);
+    return failures;
+}
+
+/*
+ * =============================================================================
+ * Phase 2: streamed properties (C against C, no Cryptol reference)
+ * Inputs come from splitmix64 (the generator of the vec* rows in
+ * aes_pbt.cry), one thread per stream.
+ * =============================================================================
+ */
+
+static uint64_t splitmix64(uint64_t *s) {
+    uint64_t z = (*s += 0x9e3779b97f4a7c15ULL);
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t draw(uint64_t *s) {
+    uint64_t x = splitmix64(s), e;
+
+    if (x % EDGE_ODDS != 0)
+        return splitmix64(s);
+    e = splitmix64(s);
+    switch (e % 5) {
+    case 0: return 0;
+    case 1: return ~0ULL;
+    case 2: return 1ULL << (e >> 8) % 64;
+    case 3: return ~(1ULL << (e >> 8) % 64);
+    default: return 0x0101010101010101ULL * ((e >> 8) & 0xFF);
+    }
+}
+
+// A property reads its inputs from a[] (filled by the caller) and
+// returns nonzero if it holds
+typedef int (*prop_fn)(const uint64_t a[]);
+
+struct prop_entry {
+    const char *name;
+    int nin;
+    prop_fn check;
+};
+
+// FIPS-197 round constants, in the top byte of the word
+static const uint32_t rcon_words[11] = {
+    0, 0x01000000, 0x02000000, 0x04000000, 0x08000000, 0x10000000,
+    0x20000000, 0x40000000, 0x80000000, 0x1b000000, 0x36000000,
+};
+
+static uint64_t sbox_bytes(uint64_t x) {
+    uint64_t r = 0;
+    int i;
+
+    for (i = 0; i < 64; i += 8)
+        r |= (uint64_t)pbt_SBox((uint8_t)(x >> i)) << i;
+    return r;
+}
+
+// SBoxInverts, both ways
+static int prop_sbox(const uint64_t a[]) {
+    uint8_t b = (uint8_t)a[0];
+    return pbt_InvSBox(pbt_SBox(b)) == b && pbt_SBox(pbt_InvSBox(b)) == b;
+}
+
+// SubBytes / SubWord are SBox on every byte, and InvSubBytes undoes SubBytes
+static int prop_subbytes(const uint64_t a[]) {
+    uint64_t lo = pbt_SubBytes_lo(a[0], a[1]), hi = pbt_SubBytes_hi(a[0], a[1]);
+    uint32_t w = (uint32_t)a[0];
+
+    return lo == sbox_bytes(a[0]) && hi == sbox_bytes(a[1])
+        && pbt_SubWord(w) == (uint32_t)sbox_bytes(w)
+        && pbt_InvSubBytes_lo(lo, hi) == a[0] && pbt_InvSubBytes_hi(lo, hi) == a[1];
+}
+
+// ShiftRowsInverts, and ShiftRows(x ^ y) == ShiftRows(x) ^ ShiftRows(y)
+static int prop_shiftrows(const uint64_t a[]) {
+    uint64_t lo = pbt_ShiftRows_lo(a[0], a[1]), hi = pbt_ShiftRows_hi(a[0], a[1]);
+
+    return pbt_InvShiftRows_lo(lo, hi) == a[0] && pbt_InvShiftRows_hi(lo, hi) == a[1]
+        && pbt_ShiftRows_lo(a[0] ^ a[2], a[1] ^ a[3]) == (lo ^ pbt_ShiftRows_lo(a[2], a[3]))
+        && pbt_ShiftRows_hi(a[0] ^ a[2], a[1] ^ a[3]) == (hi ^ pbt_ShiftRows_hi(a[2], a[3]));
+}
+
+// MixColumnsInverts, and both directions are linear over GF(2)
+static int prop_mixcolumns(const uint64_t a[]) {
+    uint64_t lo = pbt_MixColumns_lo(a[0], a[1]), hi = pbt_MixColumns_hi(a[0], a[1]);
+    uint64_t ilo = pbt_InvMixColumns_lo(a[0], a[1]), ihi = pbt_InvMixColumns_hi(a[0], a[1]);
+
+    return pbt_InvMixColumns_lo(lo, hi) == a[0] && pbt_InvMixColumns_hi(lo, hi) == a[1]
+        && pbt_MixColumns_lo(a[0] ^ a[2], a[1] ^ a[3]) == (lo ^ pbt_MixColumns_lo(a[2], a[3]))
+        && pbt_MixColumns_hi(a[0] ^ a[2], a[1] ^ a[3]) == (hi ^ pbt_MixColumns_hi(a[2], a[3]))
+        && pbt_InvMixColumns_lo(a[0] ^ a[2], a[1] ^ a[3]) == (ilo ^ pbt_InvMixColumns_lo(a[2], a[3]))
+        && pbt_InvMixColumns_hi(a[0] ^ a[2], a[1] ^ a[3]) == (ihi ^ pbt_InvMixColumns_hi(a[2], a[3]));
+}
+
+// AddRoundKeySelfInverse, and AddRoundKey(0, k) is the key in state order
+static int prop_addroundkey(const uint64_t a[]) {
+    uint64_t lo = pbt_AddRoundKey_lo(a[0], a[1], a[2], a[3]);
+    uint64_t hi = pbt_AddRoundKey_hi(a[0], a[1], a[2], a[3]);
+
+    return pbt_AddRoundKey_lo(lo, hi, a[2], a[3]) == a[0]
+        && pbt_AddRoundKey_hi(lo, hi, a[2], a[3]) == a[1]
+        && (lo ^ a[0]) == pbt_AddRoundKey_lo(0, 0, a[2], a[3])
+        && (hi ^ a[1]) == pbt_AddRoundKey_hi(0, 0, a[2], a[3]);
+}
+
+// The AES-128 schedule starts with the key and follows the FIPS-197
+// recurrence (KeyExpansionStep / KeyExpansionStepSimple); RoundKey packs
+// four schedule words
+static int prop_keyschedule(const uint64_t a[]) {
+    uint32_t i = 4 + (uint32_t)(a[2] % 40), r = (uint32_t)(a[2] % 11);
+    uint32_t w = pbt_KeyScheduleWord(a[0], a[1], i);
+    uint32_t prev = pbt_KeyScheduleWord(a[0], a[1], i - 1);
+    uint32_t nk = pbt_KeyScheduleWord(a[0], a[1], i - 4);
+    uint32_t step = (i % 4 == 0) ? pbt_KeyExpansionStep(prev, nk, rcon_words[i / 4])
+                                 : pbt_KeyExpansionStepSimple(prev, nk);
+
+    return w == step
+        && pbt_KeyScheduleWord(a[0], a[1], i % 4) == (uint32_t)((i % 4 < 2 ? a[0] : a[1]) >> (i % 2 ? 0 : 32))
+        && pbt_RoundKey_lo(a[0], a[1], r) == ((uint64_t)pbt_KeyScheduleWord(a[0], a[1], 4 * r) << 32
+                                              | pbt_KeyScheduleWord(a[0], a[1], 4 * r + 1));
+}
+
+// encryptDecryptRoundTrip, and batchMatchesSingle on two blocks
+static int prop_cipher128(const uint64_t a[]) {
+    uint64_t lo = pbt_aes_encrypt_lo(a[0], a[1], a[2], a[3]);
+    uint64_t hi = pbt_aes_encrypt_hi(a[0], a[1], a[2], a[3]);
+    uint64_t in[4] = { a[0], a[1], a[4], a[5] }, out[4], back[4];
+
+    pbt_aes_encrypt_batch(a[2], a[3], in, out, 2);
+    pbt_aes_decrypt_batch(a[2], a[3], out, back, 2);
+    return pbt_aes_decrypt_lo(lo, hi, a[2], a[3]) == a[0]
+        && pbt_aes_decrypt_hi(lo, hi, a[2], a[3]) == a[1]
+        && out[0] == lo && out[1] == hi
+        && out[2] == pbt_aes_encrypt_lo(a[4], a[5], a[2], a[3])
+        && memcmp(back, in, sizeof(in)) == 0;
+}
+
+static int prop_cipher192(const uint64_t a[]) {
+    uint64_t lo = pbt_aes_encrypt_192_lo(a[0], a[1], a[2], a[3], a[4]);
+    uint64_t hi = pbt_aes_encrypt_192_hi(a[0], a[1], a[2], a[3], a[4]);
+
+    return pbt_aes_decrypt_192_lo(lo, hi, a[2], a[3], a[4]) == a[0]
+        && pbt_aes_decrypt_192_hi(lo, hi, a[2], a[3], a[4]) == a[1];
+}
+
+static int prop_cipher256(const uint64_t a[]) {
+    uint64_t lo = pbt_aes_encrypt_256_lo(a[0], a[1], a[2], a[3], a[4], a[5]);
+    uint64_t hi = pbt_aes_encrypt_256_hi(a[0], a[1], a[2], a[3], a[4], a[5]);
+
+    return pbt_aes_decrypt_256_lo(lo, hi, a[2], a[3], a[4], a[5]) == a[0]
+        && pbt_aes_decrypt_256_hi(lo, hi, a[2], a[3], a[4], a[5]) == a[1];
+}
+
+static const struct prop_entry prop_table[] = {
+    { "SBoxInverts", 1, prop_sbox },
+    { "SubBytes", 2, prop_subbytes },
+    { "ShiftRows", 4, prop_shiftrows },
+    { "MixColumns", 4, prop_mixcolumns },
+    { "AddRoundKey", 4, prop_addroundkey },
+    { "KeySchedule", 3, prop_keyschedule },
+    { "Cipher128", 6, prop_cipher128 },
+    { "Cipher192", 5, prop_cipher192 },
+    { "Cipher256", 6, prop_cipher256 },
+};
+
+#define NPROP (sizeof(prop_table) / sizeof(prop_table[0]))
+
+struct worker {
+    pthread_t th;
+    uint64_t seed;
+    unsigned long long cases[NPROP];
+    unsigned long long failures;
+};
+
+static atomic_int stop;
+static atomic_int reports;
+static pthread_mutex_t report_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void report(const struct prop_entry *p, const uint64_t a[]) {
+    int i;
+
+    if (atomic_fetch_add(&reports, 1) >= MAX_REPORTS)
+        return;
+    pthread_mutex_lock(&report_lock);
+    printf("  FAIL %s:", p->name);
+    for (i = 0; i < p->nin; i++)
+        printf(" 0x%016llx", (unsigned long long)a[i]);
+    printf("\n");
+    pthread_mutex_unlock(&report_lock);
+}
+
+static void *stream(void *arg) {
+    struct worker *w = arg;
+    uint64_t s = w->seed, a[MAX_ARGS];
+    unsigned long n;
+    size_t p;
+    int i;
+
+    while (!atomic_load_explicit(&stop, memory_order_relaxed)) {
+        for (n = 0; n < 256; n++)
+            for (p = 0; p < NPROP; p++) {
+                for (i = 0; i < prop_table[p].nin; i++)
+                    a[i] = draw(&s);
+                if (!prop_table[p].check(a)) {
+                    w->failures++;
+                    report(&prop_table[p], a);
+                }
+                w->cases[p]++;
+            }
+    }
+    return NULL;
+}
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char **argv) {
+    double seconds = 10, start, elapsed;
+    long threads = 0, mismatches = 0;
+    uint64_t seed = 1, s;
+    unsigned long long total = 0, failures = 0, per_prop;
+    struct worker *ws;
+    size_t p;
+    int opt;
+    long t;
+
+    while ((opt = getopt(argc, argv, "s:j:r:")) != -1) {
+        switch (opt) {
+        case 's': seconds = atof(optarg); break;
+        case 'j': threads = atol(optarg); break;
+        case 'r': seed = strtoull(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-s seconds] [-j threads] [-r seed] [vectors.txt]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threads <= 0)
+        threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (threads <= 0)
+        threads = 1;
+
+    if (optind < argc) {
+        mismatches = replay_vectors(argv[optind]);
+        if (mismatches < 0)
+            return 2;
+    }
+
+    ws = calloc(threads, sizeof(*ws));
+    if (!ws)
+        return 2;
+    s = seed;
+    start = now();
+    for (t = 0; t < threads; t++) {
+        ws[t].seed = splitmix64(&s);
+        pthread_create(&ws[t].th, NULL, stream, &ws[t]);
+    }
+    while (now() - start < seconds)
+        usleep(10000);
+    atomic_store(&stop, 1);
+    for (t = 0; t < threads; t++)
+        pthread_join(ws[t].th, NULL);
+    elapsed = now() - start;
+
+    for (p = 0; p < NPROP; p++) {
+        per_prop = 0;
+        for (t = 0; t < threads; t++)
+            per_prop += ws[t].cases[p];
+        printf("  %-12s %12llu cases\n", prop_table[p].name, per_prop);
+        total += per_prop;
+    }
+    for (t = 0; t < threads; t++)
+        failures += ws[t].failures;
+    printf("stream: %llu cases in %.1f s on %ld threads (%.1f M/min, seed %llu), %llu failures\n",
+           total, elapsed, threads, total / elapsed * 60 / 1e6, (unsigned long long)seed, failures);
+    free(ws);
+
+    if (mismatches || failures) {
+        printf("aes_pbt_fuzz: FAILED\n");
+        return 1;
+    }
+    printf("aes_pbt_fuzz: all vectors and properties passed\n");
+    return 0;
+}
@@ -423,3 +423,246 @@ uint64_t pbt_aes_decrypt_hi(uint64_t ct_lo, uint64_t ct_hi,
 
     return pack_block_hi(plaintext);
 }
+
+/*
+ * =============================================================================
+ * Batched AES-128 Encryption/Decryption
+ *
+ * The per-block wrappers above run aes_key_setup on every call, and the
+ * lo/hi split means every random test pays for two key expansions per
+ * direction. The batch entry points expand the key ONCE and then process
+ * nblocks packed blocks against the shared schedule.
+ *
+ * Block packing: blocks[2*i] is block i's lo half, blocks[2*i + 1] its hi
+ * half (same big-endian convention as pack_block_lo/pack_block_hi).
+ *
+ * These take pointers, so aes_pbt.saw checks them with llvm_verify and
+ * quickcheck as the proof tactic instead of llvm_extract, on batches of
+ * batch_blocks (8) blocks.
+ * =============================================================================
+ */
+
+void pbt_aes_encrypt_batch(uint64_t key_lo, uint64_t key_hi,
+                           const uint64_t in[], uint64_t out[],
+                           uint32_t nblocks) {
+    BYTE plaintext[16], ciphertext[16], key[16];
+    WORD key_schedule[60];
+    uint32_t i;
+
+    unpack_key(key_lo, key_hi, key);
+    aes_key_setup(key, key_schedule, 128);
+
+    for (i = 0; i < nblocks; i++) {
+        unpack_block(in[2 * i], in[2 * i + 1], plaintext);
+        aes_encrypt(plaintext, ciphertext, key_schedule, 128);
+        out[2 * i] = pack_block_lo(ciphertext);
+        out[2 * i + 1] = pack_block_hi(ciphertext);
+    }
+}
+
+void pbt_aes_decrypt_batch(uint64_t key_lo, uint64_t key_hi,
+                           const uint64_t in[], uint64_t out[],
+                           uint32_t nblocks) {
+    BYTE ciphertext[16], plaintext[16], key[16];
+    WORD key_schedule[60];
+    uint32_t i;
+
+    unpack_key(key_lo, key_hi, key);
+    aes_key_setup(key, key_schedule, 128);
+
+    for (i = 0; i < nblocks; i++) {
+        unpack_block(in[2 * i], in[2 * i + 1], ciphertext);
+        aes_decrypt(ciphertext, plaintext, key_schedule, 128);
+        out[2 * i] = pack_block_lo(plaintext);
+        out[2 * i + 1] = pack_block_hi(plaintext);
+    }
+}
+
+/*
+ * =============================================================================
+ * AES-192 / AES-256 Key Expansion and Encryption/Decryption
+ *
+ * The same wrappers as above for the longer keys. A 192-bit key is passed
+ * as three uint64 (k0 = key bytes 0-7, big-endian, ...), a 256-bit key as
+ * four. Schedules have 52 words (13 round keys) and 60 words (15 round
+ * keys); indices past the end are clamped to the last word / round.
+ * =============================================================================
+ */
+
+// Helper: unpack a uint64 into 8 bytes (big-endian)
+static void unpack_u64(uint64_t v, BYTE out[8]) {
+    int i;
+
+    for (i = 0; i < 8; i++)
+        out[i] = (v >> (56 - 8 * i)) & 0xFF;
+}
+
+static void key_setup_192(uint64_t k0, uint64_t k1, uint64_t k2, WORD key_schedule[60]) {
+    BYTE key[24];
+
+    unpack_u64(k0, key);
+    unpack_u64(k1, key + 8);
+    unpack_u64(k2, key + 16);
+    aes_key_setup(key, key_schedule, 192);
+}
+
+static void key_setup_256(uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3,
+                          WORD key_schedule[60]) {
+    BYTE key[32];
+
+    unpack_u64(k0, key);
+    unpack_u64(k1, key + 8);
+    unpack_u64(k2, key + 16);
+    unpack_u64(k3, key + 24);
+    aes_key_setup(key, key_schedule, 256);
+}
+
+// AES-192: word_index 0 to 51, round 0 to 12
+uint32_t pbt_KeyScheduleWord_192(uint64_t k0, uint64_t k1, uint64_t k2,
+                                 uint32_t word_index) {
+    WORD key_schedule[60];
+
+    key_setup_192(k0, k1, k2, key_schedule);
+    if (word_index > 51) word_index = 51;
+    return key_schedule[word_index];
+}
+
+uint64_t pbt_RoundKey_192_lo(uint64_t k0, uint64_t k1, uint64_t k2, uint32_t round) {
+    WORD key_schedule[60];
+
+    key_setup_192(k0, k1, k2, key_schedule);
+    if (round > 12) round = 12;
+    return ((uint64_t)key_schedule[round * 4] << 32) | key_schedule[round * 4 + 1];
+}
+
+uint64_t pbt_RoundKey_192_hi(uint64_t k0, uint64_t k1, uint64_t k2, uint32_t round) {
+    WORD key_schedule[60];
+
+    key_setup_192(k0, k1, k2, key_schedule);
+    if (round > 12) round = 12;
+    return ((uint64_t)key_schedule[round * 4 + 2] << 32) | key_schedule[round * 4 + 3];
+}
+
+// AES-256: word_index 0 to 59, round 0 to 14
+uint32_t pbt_KeyScheduleWord_256(uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3,
+                                 uint32_t word_index) {
+    WORD key_schedule[60];
+
+    key_setup_256(k0, k1, k2, k3, key_schedule);
+    if (word_index > 59) word_index = 59;
+    return key_schedule[word_index];
+}
+
+uint64_t pbt_RoundKey_256_lo(uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3,
+                             uint32_t round) {
+    WORD key_schedule[60];
+
+    key_setup_256(k0, k1, k2, k3, key_schedule);
+    if (round > 14) round = 14;
+    return ((uint64_t)key_schedule[round * 4] << 32) | key_schedule[round * 4 + 1];
+}
+
+uint64_t pbt_RoundKey_256_hi(uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3,
+                             uint32_t round) {
+    WORD key_schedule[60];
+
+    key_setup_256(k0, k1, k2, k3, key_schedule);
+    if (round > 14) round = 14;
+    return ((uint64_t)key_schedule[round * 4 + 2] << 32) | key_schedule[round * 4 + 3];
+}
+
+uint64_t pbt_aes_encrypt_192_lo(uint64_t pt_lo, uint64_t pt_hi,
+                                uint64_t k0, uint64_t k1, uint64_t k2) {
+    BYTE plaintext[16], ciphertext[16];
+    WORD key_schedule[60];
+
+    unpack_block(pt_lo, pt_hi, plaintext);
+    key_setup_192(k0, k1, k2, key_schedule);
+    aes_encrypt(plaintext, ciphertext, key_schedule, 192);
+
+    return pack_block_lo(ciphertext);
+}
+
+uint64_t pbt_aes_encrypt_192_hi(uint64_t pt_lo, uint64_t pt_hi,
+                                uint64_t k0, uint64_t k1, uint64_t k2) {
+    BYTE plaintext[16], ciphertext[16];
+    WORD key_schedule[60];
+
+    unpack_block(pt_lo, pt_hi, plaintext);
+    key_setup_192(k0, k1, k2, key_schedule);
+    aes_encrypt(plaintext, ciphertext, key_schedule, 192);
+
+    return pack_block_hi(ciphertext);
+}
+
+uint64_t pbt_aes_decrypt_192_lo(uint64_t ct_lo, uint64_t ct_hi,
+                                uint64_t k0, uint64_t k1, uint64_t k2) {
+    BYTE ciphertext[16], plaintext[16];
+    WORD key_schedule[60];
+
+    unpack_block(ct_lo, ct_hi, ciphertext);
+    key_setup_192(k0, k1, k2, key_schedule);
+    aes_decrypt(ciphertext, plaintext, key_schedule, 192);
+
+    return pack_block_lo(plaintext);
+}
+
+uint64_t pbt_aes_decrypt_192_hi(uint64_t ct_lo, uint64_t ct_hi,
+                                uint64_t k0, uint64_t k1, uint64_t k2) {
+    BYTE ciphertext[16], plaintext[16];
+    WORD key_schedule[60];
+
+    unpack_block(ct_lo, ct_hi, ciphertext);
+    key_setup_192(k0, k1, k2, key_schedule);
+    aes_decrypt(ciphertext, plaintext, key_schedule, 192);
+
+    return pack_block_hi(plaintext);
+}
+
+uint64_t pbt_aes_encrypt_256_lo(uint64_t pt_lo, uint64_t pt_hi,
+                                uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3) {
+    BYTE plaintext[16], ciphertext[16];
+    WORD key_schedule[60];
+
+    unpack_block(pt_lo, pt_hi, plaintext);
+    key_setup_256(k0, k1, k2, k3, key_schedule);
+    aes_encrypt(plaintext, ciphertext, key_schedule, 256);
+
+    return pack_block_lo(ciphertext);
+}
+
+uint64_t pbt_aes_encrypt_256_hi(uint64_t pt_lo, uint64_t pt_hi,
+                                uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3) {
+    BYTE plaintext[16], ciphertext[16];
+    WORD key_schedule[60];
+
+    unpack_block(pt_lo, pt_hi, plaintext);
+    key_setup_256(k0, k1, k2, k3, key_schedule);
+    aes_encrypt(plaintext, ciphertext, key_schedule, 256);
+
+    return pack_block_hi(ciphertext);
+}
+
+uint64_t pbt_aes_decrypt_256_lo(uint64_t ct_lo, uint64_t ct_hi,
+                                uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3) {
+    BYTE ciphertext[16], plaintext[16];
+    WORD key_schedule[60];
+
+    unpack_block(ct_lo, ct_hi, ciphertext);
+    key_setup_256(k0, k1, k2, k3, key_schedule);
+    aes_decrypt(ciphertext, plaintext, key_schedule, 256);
+
+    return pack_block_lo(plaintext);
+}
+
+uint64_t pbt_aes_decrypt_256_hi(uint64_t ct_lo, uint64_t ct_hi,
+                                uint64_t k0, uint64_t k1, uint64_t k2, uint64_t k3) {
+    BYTE ciphertext[16], plaintext[16];
+    WORD key_schedule[60];
+
+    unpack_block(ct_lo, ct_hi, ciphertext);
+    key_setup_256(k0, k1, k2, k3, key_schedule);
+    aes_decrypt(ciphertext, plaintext, key_schedule, 256);
+
+    return pack_block_hi(plaintext);
+}
@@ -0,0 +1,217 @@
+/*********************************************************************
+* Filename:   aes_ttable_inv.c
+* Purpose:    Inverse T-table round for the equivalent inverse cipher
+*
+* Key insight: with InvMixColumns already applied to the round keys
+* (aes_key_ctx.c), a middle decryption round is
+*
+*   AddRoundKey(dk, InvMixColumns(InvSubBytes(InvShiftRows(state))))
+*
+* the same shape as an encryption round, so it collapses into four table
+* lookups per column the way aes_ttable.c does for encryption:
+*
+*   column'[c] = Td0[s[0][c]] ^ Td1[s[1][c-1]] ^ Td2[s[2][c-2]]
+*              ^ Td3[s[3][c-3]] ^ dk[c]
+*
+* where TdN[b] is InvMixColumns column N applied to InvSBox(b).
+*
+* Word convention: same as the key schedule. A column word holds
+* row 0 in bits 31..24 down to row 3 in bits 7..0.
+*********************************************************************/
+
+#include "../repo/aes.h"
+
+// Td0[b] = { 14*S'[b],  9*S'[b], 13*S'[b], 11*S'[b] }   (InvMixColumns column 0)
+// Td1[b] = { 11*S'[b], 14*S'[b],  9*S'[b], 13*S'[b] }   (InvMixColumns column 1)
+// Td2[b] = { 13*S'[b], 11*S'[b], 14*S'[b],  9*S'[b] }   (InvMixColumns column 2)
+// Td3[b] = {  9*S'[b], 13*S'[b], 11*S'[b], 14*S'[b] }   (InvMixColumns column 3)
+// with S' the inverse S-box
+static const WORD aes_td0[256] = {
+	0x51F4A750,0x7E416553,0x1A17A4C3,0x3A275E96,0x3BAB6BCB,0x1F9D45F1,0xACFA58AB,0x4BE30393,
+	0x2030FA55,0xAD766DF6,0x88CC7691,0xF5024C25,0x4FE5D7FC,0xC52ACBD7,0x26354480,0xB562A38F,
+	0xDEB15A49,0x25BA1B67,0x45EA0E98,0x5DFEC0E1,0xC32F7502,0x814CF012,0x8D4697A3,0x6BD3F9C6,
+	0x038F5FE7,0x15929C95,0xBF6D7AEB,0x955259DA,0xD4BE832D,0x587421D3,0x49E06929,0x8EC9C844,
+	0x75C2896A,0xF48E7978,0x99583E6B,0x27B971DD,0xBEE14FB6,0xF088AD17,0xC920AC66,0x7DCE3AB4,
+	0x63DF4A18,0xE51A3182,0x97513360,0x62537F45,0xB16477E0,0xBB6BAE84,0xFE81A01C,0xF9082B94,
+	0x70486858,0x8F45FD19,0x94DE6C87,0x527BF8B7,0xAB73D323,0x724B02E2,0xE31F8F57,0x6655AB2A,
+	0xB2EB2807,0x2FB5C203,0x86C57B9A,0xD33708A5,0x302887F2,0x23BFA5B2,0x02036ABA,0xED16825C,
+	0x8ACF1C2B,0xA779B492,0xF307F2F0,0x4E69E2A1,0x65DAF4CD,0x0605BED5,0xD134621F,0xC4A6FE8A,
+	0x342E539D,0xA2F355A0,0x058AE132,0xA4F6EB75,0x0B83EC39,0x4060EFAA,0x5E719F06,0xBD6E1051,
+	0x3E218AF9,0x96DD063D,0xDD3E05AE,0x4DE6BD46,0x91548DB5,0x71C45D05,0x0406D46F,0x605015FF,
+	0x1998FB24,0xD6BDE997,0x894043CC,0x67D99E77,0xB0E842BD,0x07898B88,0xE7195B38,0x79C8EEDB,
+	0xA17C0A47,0x7C420FE9,0xF8841EC9,0x00000000,0x09808683,0x322BED48,0x1E1170AC,0x6C5A724E,
+	0xFD0EFFFB,0x0F853856,0x3DAED51E,0x362D3927,0x0A0FD964,0x685CA621,0x9B5B54D1,0x24362E3A,
+	0x0C0A67B1,0x9357E70F,0xB4EE96D2,0x1B9B919E,0x80C0C54F,0x61DC20A2,0x5A774B69,0x1C121A16,
+	0xE293BA0A,0xC0A02AE5,0x3C22E043,0x121B171D,0x0E090D0B,0xF28BC7AD,0x2DB6A8B9,0x141EA9C8,
+	0x57F11985,0xAF75074C,0xEE99DDBB,0xA37F60FD,0xF701269F,0x5C72F5BC,0x44663BC5,0x5BFB7E34,
+	0x8B432976,0xCB23C6DC,0xB6EDFC68,0xB8E4F163,0xD731DCCA,0x42638510,0x13972240,0x84C61120,
+	0x854A247D,0xD2BB3DF8,0xAEF93211,0xC729A16D,0x1D9E2F4B,0xDCB230F3,0x0D8652EC,0x77C1E3D0,
+	0x2BB3166C,0xA970B999,0x119448FA,0x47E96422,0xA8FC8CC4,0xA0F03F1A,0x567D2CD8,0x223390EF,
+	0x87494EC7,0xD938D1C1,0x8CCAA2FE,0x98D40B36,0xA6F581CF,0xA57ADE28,0xDAB78E26,0x3FADBFA4,
+	0x2C3A9DE4,0x5078920D,0x6A5FCC9B,0x547E4662,0xF68D13C2,0x90D8B8E8,0x2E39F75E,0x82C3AFF5,
+	0x9F5D80BE,0x69D0937C,0x6FD52DA9,0xCF2512B3,0xC8AC993B,0x10187DA7,0xE89C636E,0xDB3BBB7B,
+	0xCD267809,0x6E5918F4,0xEC9AB701,0x834F9AA8,0xE6956E65,0xAAFFE67E,0x21BCCF08,0xEF15E8E6,
+	0xBAE79BD9,0x4A6F36CE,0xEA9F09D4,0x29B07CD6,0x31A4B2AF,0x2A3F2331,0xC6A59430,0x35A266C0,
+	0x744EBC37,0xFC82CAA6,0xE090D0B0,0x33A7D815,0xF104984A,0x41ECDAF7,0x7FCD500E,0x1791F62F,
+	0x764DD68D,0x43EFB04D,0xCCAA4D54,0xE49604DF,0x9ED1B5E3,0x4C6A881B,0xC12C1FB8,0x4665517F,
+	0x9D5EEA04,0x018C355D,0xFA877473,0xFB0B412E,0xB3671D5A,0x92DBD252,0xE9105633,0x6DD64713,
+	0x9AD7618C,0x37A10C7A,0x59F8148E,0xEB133C89,0xCEA927EE,0xB761C935,0xE11CE5ED,0x7A47B13C,
+	0x9CD2DF59,0x55F2733F,0x1814CE79,0x73C737BF,0x53F7CDEA,0x5FFDAA5B,0xDF3D6F14,0x7844DB86,
+	0xCAAFF381,0xB968C43E,0x3824342C,0xC2A3405F,0x161DC372,0xBCE2250C,0x283C498B,0xFF0D9541,
+	0x39A80171,0x080CB3DE,0xD8B4E49C,0x6456C190,0x7BCB8461,0xD532B670,0x486C5C74,0xD0B85742
+};
+
+static const WORD aes_td1[256] = {
+	0x5051F4A7,0x537E4165,0xC31A17A4,0x963A275E,0xCB3BAB6B,0xF11F9D45,0xABACFA58,0x934BE303,
+	0x552030FA,0xF6AD766D,0x9188CC76,0x25F5024C,0xFC4FE5D7,0xD7C52ACB,0x80263544,0x8FB562A3,
+	0x49DEB15A,0x6725BA1B,0x9845EA0E,0xE15DFEC0,0x02C32F75,0x12814CF0,0xA38D4697,0xC66BD3F9,
+	0xE7038F5F,0x9515929C,0xEBBF6D7A,0xDA955259,0x2DD4BE83,0xD3587421,0x2949E069,0x448EC9C8,
+	0x6A75C289,0x78F48E79,0x6B99583E,0xDD27B971,0xB6BEE14F,0x17F088AD,0x66C920AC,0xB47DCE3A,
+	0x1863DF4A,0x82E51A31,0x60975133,0x4562537F,0xE0B16477,0x84BB6BAE,0x1CFE81A0,0x94F9082B,
+	0x58704868,0x198F45FD,0x8794DE6C,0xB7527BF8,0x23AB73D3,0xE2724B02,0x57E31F8F,0x2A6655AB,
+	0x07B2EB28,0x032FB5C2,0x9A86C57B,0xA5D33708,0xF2302887,0xB223BFA5,0xBA02036A,0x5CED1682,
+	0x2B8ACF1C,0x92A779B4,0xF0F307F2,0xA14E69E2,0xCD65DAF4,0xD50605BE,0x1FD13462,0x8AC4A6FE,
+	0x9D342E53,0xA0A2F355,0x32058AE1,0x75A4F6EB,0x390B83EC,0xAA4060EF,0x065E719F,0x51BD6E10,
+	0xF93E218A,0x3D96DD06,0xAEDD3E05,0x464DE6BD,0xB591548D,0x0571C45D,0x6F0406D4,0xFF605015,
+	0x241998FB,0x97D6BDE9,0xCC894043,0x7767D99E,0xBDB0E842,0x8807898B,0x38E7195B,0xDB79C8EE,
+	0x47A17C0A,0xE97C420F,0xC9F8841E,0x00000000,0x83098086,0x48322BED,0xAC1E1170,0x4E6C5A72,
+	0xFBFD0EFF,0x560F8538,0x1E3DAED5,0x27362D39,0x640A0FD9,0x21685CA6,0xD19B5B54,0x3A24362E,
+	0xB10C0A67,0x0F9357E7,0xD2B4EE96,0x9E1B9B91,0x4F80C0C5,0xA261DC20,0x695A774B,0x161C121A,
+	0x0AE293BA,0xE5C0A02A,0x433C22E0,0x1D121B17,0x0B0E090D,0xADF28BC7,0xB92DB6A8,0xC8141EA9,
+	0x8557F119,0x4CAF7507,0xBBEE99DD,0xFDA37F60,0x9FF70126,0xBC5C72F5,0xC544663B,0x345BFB7E,
+	0x768B4329,0xDCCB23C6,0x68B6EDFC,0x63B8E4F1,0xCAD731DC,0x10426385,0x40139722,0x2084C611,
+	0x7D854A24,0xF8D2BB3D,0x11AEF932,0x6DC729A1,0x4B1D9E2F,0xF3DCB230,0xEC0D8652,0xD077C1E3,
+	0x6C2BB316,0x99A970B9,0xFA119448,0x2247E964,0xC4A8FC8C,0x1AA0F03F,0xD8567D2C,0xEF223390,
+	0xC787494E,0xC1D938D1,0xFE8CCAA2,0x3698D40B,0xCFA6F581,0x28A57ADE,0x26DAB78E,0xA43FADBF,
+	0xE42C3A9D,0x0D507892,0x9B6A5FCC,0x62547E46,0xC2F68D13,0xE890D8B8,0x5E2E39F7,0xF582C3AF,
+	0xBE9F5D80,0x7C69D093,0xA96FD52D,0xB3CF2512,0x3BC8AC99,0xA710187D,0x6EE89C63,0x7BDB3BBB,
+	0x09CD2678,0xF46E5918,0x01EC9AB7,0xA8834F9A,0x65E6956E,0x7EAAFFE6,0x0821BCCF,0xE6EF15E8,
+	0xD9BAE79B,0xCE4A6F36,0xD4EA9F09,0xD629B07C,0xAF31A4B2,0x312A3F23,0x30C6A594,0xC035A266,
+	0x37744EBC,0xA6FC82CA,0xB0E090D0,0x1533A7D8,0x4AF10498,0xF741ECDA,0x0E7FCD50,0x2F1791F6,
+	0x8D764DD6,0x4D43EFB0,0x54CCAA4D,0xDFE49604,0xE39ED1B5,0x1B4C6A88,0xB8C12C1F,0x7F466551,
+	0x049D5EEA,0x5D018C35,0x73FA8774,0x2EFB0B41,0x5AB3671D,0x5292DBD2,0x33E91056,0x136DD647,
+	0x8C9AD761,0x7A37A10C,0x8E59F814,0x89EB133C,0xEECEA927,0x35B761C9,0xEDE11CE5,0x3C7A47B1,
+	0x599CD2DF,0x3F55F273,0x791814CE,0xBF73C737,0xEA53F7CD,0x5B5FFDAA,0x14DF3D6F,0x867844DB,
+	0x81CAAFF3,0x3EB968C4,0x2C382434,0x5FC2A340,0x72161DC3,0x0CBCE225,0x8B283C49,0x41FF0D95,
+	0x7139A801,0xDE080CB3,0x9CD8B4E4,0x906456C1,0x617BCB84,0x70D532B6,0x74486C5C,0x42D0B857
+};
+
+static const WORD aes_td2[256] = {
+	0xA75051F4,0x65537E41,0xA4C31A17,0x5E963A27,0x6BCB3BAB,0x45F11F9D,0x58ABACFA,0x03934BE3,
+	0xFA552030,0x6DF6AD76,0x769188CC,0x4C25F502,0xD7FC4FE5,0xCBD7C52A,0x44802635,0xA38FB562,
+	0x5A49DEB1,0x1B6725BA,0x0E9845EA,0xC0E15DFE,0x7502C32F,0xF012814C,0x97A38D46,0xF9C66BD3,
+	0x5FE7038F,0x9C951592,0x7AEBBF6D,0x59DA9552,0x832DD4BE,0x21D35874,0x692949E0,0xC8448EC9,
+	0x896A75C2,0x7978F48E,0x3E6B9958,0x71DD27B9,0x4FB6BEE1,0xAD17F088,0xAC66C920,0x3AB47DCE,
+	0x4A1863DF,0x3182E51A,0x33609751,0x7F456253,0x77E0B164,0xAE84BB6B,0xA01CFE81,0x2B94F908,
+	0x68587048,0xFD198F45,0x6C8794DE,0xF8B7527B,0xD323AB73,0x02E2724B,0x8F57E31F,0xAB2A6655,
+	0x2807B2EB,0xC2032FB5,0x7B9A86C5,0x08A5D337,0x87F23028,0xA5B223BF,0x6ABA0203,0x825CED16,
+	0x1C2B8ACF,0xB492A779,0xF2F0F307,0xE2A14E69,0xF4CD65DA,0xBED50605,0x621FD134,0xFE8AC4A6,
+	0x539D342E,0x55A0A2F3,0xE132058A,0xEB75A4F6,0xEC390B83,0xEFAA4060,0x9F065E71,0x1051BD6E,
+	0x8AF93E21,0x063D96DD,0x05AEDD3E,0xBD464DE6,0x8DB59154,0x5D0571C4,0xD46F0406,0x15FF6050,
+	0xFB241998,0xE997D6BD,0x43CC8940,0x9E7767D9,0x42BDB0E8,0x8B880789,0x5B38E719,0xEEDB79C8,
+	0x0A47A17C,0x0FE97C42,0x1EC9F884,0x00000000,0x86830980,0xED48322B,0x70AC1E11,0x724E6C5A,
+	0xFFFBFD0E,0x38560F85,0xD51E3DAE,0x3927362D,0xD9640A0F,0xA621685C,0x54D19B5B,0x2E3A2436,
+	0x67B10C0A,0xE70F9357,0x96D2B4EE,0x919E1B9B,0xC54F80C0,0x20A261DC,0x4B695A77,0x1A161C12,
+	0xBA0AE293,0x2AE5C0A0,0xE0433C22,0x171D121B,0x0D0B0E09,0xC7ADF28B,0xA8B92DB6,0xA9C8141E,
+	0x198557F1,0x074CAF75,0xDDBBEE99,0x60FDA37F,0x269FF701,0xF5BC5C72,0x3BC54466,0x7E345BFB,
+	0x29768B43,0xC6DCCB23,0xFC68B6ED,0xF163B8E4,0xDCCAD731,0x85104263,0x22401397,0x112084C6,
+	0x247D854A,0x3DF8D2BB,0x3211AEF9,0xA16DC729,0x2F4B1D9E,0x30F3DCB2,0x52EC0D86,0xE3D077C1,
+	0x166C2BB3,0xB999A970,0x48FA1194,0x642247E9,0x8CC4A8FC,0x3F1AA0F0,0x2CD8567D,0x90EF2233,
+	0x4EC78749,0xD1C1D938,0xA2FE8CCA,0x0B3698D4,0x81CFA6F5,0xDE28A57A,0x8E26DAB7,0xBFA43FAD,
+	0x9DE42C3A,0x920D5078,0xCC9B6A5F,0x4662547E,0x13C2F68D,0xB8E890D8,0xF75E2E39,0xAFF582C3,
+	0x80BE9F5D,0x937C69D0,0x2DA96FD5,0x12B3CF25,0x993BC8AC,0x7DA71018,0x636EE89C,0xBB7BDB3B,
+	0x7809CD26,0x18F46E59,0xB701EC9A,0x9AA8834F,0x6E65E695,0xE67EAAFF,0xCF0821BC,0xE8E6EF15,
+	0x9BD9BAE7,0x36CE4A6F,0x09D4EA9F,0x7CD629B0,0xB2AF31A4,0x23312A3F,0x9430C6A5,0x66C035A2,
+	0xBC37744E,0xCAA6FC82,0xD0B0E090,0xD81533A7,0x984AF104,0xDAF741EC,0x500E7FCD,0xF62F1791,
+	0xD68D764D,0xB04D43EF,0x4D54CCAA,0x04DFE496,0xB5E39ED1,0x881B4C6A,0x1FB8C12C,0x517F4665,
+	0xEA049D5E,0x355D018C,0x7473FA87,0x412EFB0B,0x1D5AB367,0xD25292DB,0x5633E910,0x47136DD6,
+	0x618C9AD7,0x0C7A37A1,0x148E59F8,0x3C89EB13,0x27EECEA9,0xC935B761,0xE5EDE11C,0xB13C7A47,
+	0xDF599CD2,0x733F55F2,0xCE791814,0x37BF73C7,0xCDEA53F7,0xAA5B5FFD,0x6F14DF3D,0xDB867844,
+	0xF381CAAF,0xC43EB968,0x342C3824,0x405FC2A3,0xC372161D,0x250CBCE2,0x498B283C,0x9541FF0D,
+	0x017139A8,0xB3DE080C,0xE49CD8B4,0xC1906456,0x84617BCB,0xB670D532,0x5C74486C,0x5742D0B8
+};
+
+static const WORD aes_td3[256] = {
+	0xF4A75051,0x4165537E,0x17A4C31A,0x275E963A,0xAB6BCB3B,0x9D45F11F,0xFA58ABAC,0xE303934B,
+	0x30FA5520,0x766DF6AD,0xCC769188,0x024C25F5,0xE5D7FC4F,0x2ACBD7C5,0x35448026,0x62A38FB5,
+	0xB15A49DE,0xBA1B6725,0xEA0E9845,0xFEC0E15D,0x2F7502C3,0x4CF01281,0x4697A38D,0xD3F9C66B,
+	0x8F5FE703,0x929C9515,0x6D7AEBBF,0x5259DA95,0xBE832DD4,0x7421D358,0xE0692949,0xC9C8448E,
+	0xC2896A75,0x8E7978F4,0x583E6B99,0xB971DD27,0xE14FB6BE,0x88AD17F0,0x20AC66C9,0xCE3AB47D,
+	0xDF4A1863,0x1A3182E5,0x51336097,0x537F4562,0x6477E0B1,0x6BAE84BB,0x81A01CFE,0x082B94F9,
+	0x48685870,0x45FD198F,0xDE6C8794,0x7BF8B752,0x73D323AB,0x4B02E272,0x1F8F57E3,0x55AB2A66,
+	0xEB2807B2,0xB5C2032F,0xC57B9A86,0x3708A5D3,0x2887F230,0xBFA5B223,0x036ABA02,0x16825CED,
+	0xCF1C2B8A,0x79B492A7,0x07F2F0F3,0x69E2A14E,0xDAF4CD65,0x05BED506,0x34621FD1,0xA6FE8AC4,
+	0x2E539D34,0xF355A0A2,0x8AE13205,0xF6EB75A4,0x83EC390B,0x60EFAA40,0x719F065E,0x6E1051BD,
+	0x218AF93E,0xDD063D96,0x3E05AEDD,0xE6BD464D,0x548DB591,0xC45D0571,0x06D46F04,0x5015FF60,
+	0x98FB2419,0xBDE997D6,0x4043CC89,0xD99E7767,0xE842BDB0,0x898B8807,0x195B38E7,0xC8EEDB79,
+	0x7C0A47A1,0x420FE97C,0x841EC9F8,0x00000000,0x80868309,0x2BED4832,0x1170AC1E,0x5A724E6C,
+	0x0EFFFBFD,0x8538560F,0xAED51E3D,0x2D392736,0x0FD9640A,0x5CA62168,0x5B54D19B,0x362E3A24,
+	0x0A67B10C,0x57E70F93,0xEE96D2B4,0x9B919E1B,0xC0C54F80,0xDC20A261,0x774B695A,0x121A161C,
+	0x93BA0AE2,0xA02AE5C0,0x22E0433C,0x1B171D12,0x090D0B0E,0x8BC7ADF2,0xB6A8B92D,0x1EA9C814,
+	0xF1198557,0x75074CAF,0x99DDBBEE,0x7F60FDA3,0x01269FF7,0x72F5BC5C,0x663BC544,0xFB7E345B,
+	0x4329768B,0x23C6DCCB,0xEDFC68B6,0xE4F163B8,0x31DCCAD7,0x63851042,0x97224013,0xC6112084,
+	0x4A247D85,0xBB3DF8D2,0xF93211AE,0x29A16DC7,0x9E2F4B1D,0xB230F3DC,0x8652EC0D,0xC1E3D077,
+	0xB3166C2B,0x70B999A9,0x9448FA11,0xE9642247,0xFC8CC4A8,0xF03F1AA0,0x7D2CD856,0x3390EF22,
+	0x494EC787,0x38D1C1D9,0xCAA2FE8C,0xD40B3698,0xF581CFA6,0x7ADE28A5,0xB78E26DA,0xADBFA43F,
+	0x3A9DE42C,0x78920D50,0x5FCC9B6A,0x7E466254,0x8D13C2F6,0xD8B8E890,0x39F75E2E,0xC3AFF582,
+	0x5D80BE9F,0xD0937C69,0xD52DA96F,0x2512B3CF,0xAC993BC8,0x187DA710,0x9C636EE8,0x3BBB7BDB,
+	0x267809CD,0x5918F46E,0x9AB701EC,0x4F9AA883,0x956E65E6,0xFFE67EAA,0xBCCF0821,0x15E8E6EF,
+	0xE79BD9BA,0x6F36CE4A,0x9F09D4EA,0xB07CD629,0xA4B2AF31,0x3F23312A,0xA59430C6,0xA266C035,
+	0x4EBC3774,0x82CAA6FC,0x90D0B0E0,0xA7D81533,0x04984AF1,0xECDAF741,0xCD500E7F,0x91F62F17,
+	0x4DD68D76,0xEFB04D43,0xAA4D54CC,0x9604DFE4,0xD1B5E39E,0x6A881B4C,0x2C1FB8C1,0x65517F46,
+	0x5EEA049D,0x8C355D01,0x877473FA,0x0B412EFB,0x671D5AB3,0xDBD25292,0x105633E9,0xD647136D,
+	0xD7618C9A,0xA10C7A37,0xF8148E59,0x133C89EB,0xA927EECE,0x61C935B7,0x1CE5EDE1,0x47B13C7A,
+	0xD2DF599C,0xF2733F55,0x14CE7918,0xC737BF73,0xF7CDEA53,0xFDAA5B5F,0x3D6F14DF,0x44DB8678,
+	0xAFF381CA,0x68C43EB9,0x24342C38,0xA3405FC2,0x1DC37216,0xE2250CBC,0x3C498B28,0x0D9541FF,
+	0xA8017139,0x0CB3DE08,0xB4E49CD8,0x56C19064,0xCB84617B,0x32B670D5,0x6C5C7448,0xB85742D0
+};
+
+// Single-table lookups, each verified with 8 bits symbolic
+__attribute__((noinline))
+WORD td0_lookup(BYTE b) {
+    return aes_td0[b];
+}
+
+__attribute__((noinline))
+WORD td1_lookup(BYTE b) {
+    return aes_td1[b];
+}
+
+__attribute__((noinline))
+WORD td2_lookup(BYTE b) {
+    return aes_td2[b];
+}
+
+__attribute__((noinline))
+WORD td3_lookup(BYTE b) {
+    return aes_td3[b];
+}
+
+// One output column of InvShiftRows + InvSubBytes + InvMixColumns.
+// a0..a3 are the (already InvShiftRows-selected) input bytes of rows 0..3.
+__attribute__((noinline))
+WORD ttable_inv_column(BYTE a0, BYTE a1, BYTE a2, BYTE a3) {
+    return td0_lookup(a0) ^ td1_lookup(a1) ^ td2_lookup(a2) ^ td3_lookup(a3);
+}
+
+// Middle round of the equivalent inverse cipher:
+// AddRoundKey(InvMixColumns(InvSubBytes(InvShiftRows(state)))), with w a
+// round key that already has InvMixColumns applied
+__attribute__((noinline))
+void ttable_inv_round(BYTE state[][4], const WORD w[]) {
+    WORD t0, t1, t2, t3;
+
+    t0 = ttable_inv_column(state[0][0], state[1][3], state[2][2], state[3][1]) ^ w[0];
+    t1 = ttable_inv_column(state[0][1], state[1][0], state[2][3], state[3][2]) ^ w[1];
+    t2 = ttable_inv_column(state[0][2], state[1][1], state[2][0], state[3][3]) ^ w[2];
+    t3 = ttable_inv_column(state[0][3], state[1][2], state[2][1], state[3][0]) ^ w[3];
+
+    state[0][0] = (BYTE)(t0 >> 24); state[0][1] = (BYTE)(t1 >> 24);
+    state[0][2] = (BYTE)(t2 >> 24); state[0][3] = (BYTE)(t3 >> 24);
+    state[1][0] = (BYTE)(t0 >> 16); state[1][1] = (BYTE)(t1 >> 16);
+    state[1][2] = (BYTE)(t2 >> 16); state[1][3] = (BYTE)(t3 >> 16);
+    state[2][0] = (BYTE)(t0 >> 8);  state[2][1] = (BYTE)(t1 >> 8);
+    state[2][2] = (BYTE)(t2 >> 8);  state[2][3] = (BYTE)(t3 >> 8);
+    state[3][0] = (BYTE)(t0);       state[3][1] = (BYTE)(t1);
+    state[3][2] = (BYTE)(t2);       state[3][3] = (BYTE)(t3);
+}
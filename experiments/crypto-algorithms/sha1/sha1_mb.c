@@ -0,0 +1,218 @@
+/*********************************************************************
+* Filename:   sha1_mb.c
+* Purpose:    Multi-buffer SHA-1: SHA1_MB_LANES independent blocks at once
+*
+* Key insight: the round update is identical for every message, so lay
+* the state out lane-major (a[lane], b[lane], ...) and run the scalar
+* round on all lanes in the same loop. The lane loops have no
+* cross-lane dependencies and compile to SIMD at -O2 (4 lanes = SSE2/
+* NEON, 8 lanes = AVX2).
+*
+* Layering mirrors sha1_single_round.c:
+*   sha1_mb_ch/parity/maj       lane-wise sha1_ch/parity/maj
+*   sha1_mb_round_ch/parity/maj lane-wise sha1_round_ch/parity/maj
+*   sha1_mb_schedule_*          lane-wise 16-word rolling schedule
+*   sha1_mb_transform           lane-wise sha1_transform
+* and sha1_verify_mb.saw verifies each level lane-wise against the
+* single-lane specs.
+*
+* sha1_mb_hash is unverified glue: it pads up to SHA1_MB_LANES
+* messages of any lengths and feeds whole blocks to sha1_mb_transform.
+*********************************************************************/
+
+#include <stdlib.h>
+#include <memory.h>
+#include "sha1.h"
+#include "sha1_mb.h"
+
+#define ROTLEFT(a, b) ((a << b) | (a >> (32 - b)))
+
+/************************ LANE PRIMITIVES ***************************/
+
+__attribute__((noinline))
+void sha1_mb_ch(WORD r[], const WORD b[], const WORD c[], const WORD d[]) {
+    int l;
+    for (l = 0; l < SHA1_MB_LANES; ++l)
+        r[l] = (b[l] & c[l]) ^ (~b[l] & d[l]);
+}
+
+__attribute__((noinline))
+void sha1_mb_parity(WORD r[], const WORD b[], const WORD c[], const WORD d[]) {
+    int l;
+    for (l = 0; l < SHA1_MB_LANES; ++l)
+        r[l] = b[l] ^ c[l] ^ d[l];
+}
+
+__attribute__((noinline))
+void sha1_mb_maj(WORD r[], const WORD b[], const WORD c[], const WORD d[]) {
+    int l;
+    for (l = 0; l < SHA1_MB_LANES; ++l)
+        r[l] = (b[l] & c[l]) ^ (b[l] & d[l]) ^ (c[l] & d[l]);
+}
+
+/************************** LANE ROUNDS *****************************/
+
+// r = one round on every lane, given f(b, c, d) for every lane
+static void sha1_mb_round(SHA1_MB_STATE *r, const SHA1_MB_STATE *s,
+                          const WORD f[], const WORD w[], WORD k) {
+    int l;
+    for (l = 0; l < SHA1_MB_LANES; ++l) {
+        r->a[l] = ROTLEFT(s->a[l], 5) + f[l] + s->e[l] + k + w[l];
+        r->b[l] = s->a[l];
+        r->c[l] = ROTLEFT(s->b[l], 30);
+        r->d[l] = s->c[l];
+        r->e[l] = s->d[l];
+    }
+}
+
+__attribute__((noinline))
+void sha1_mb_round_ch(SHA1_MB_STATE *r, const SHA1_MB_STATE *s, const WORD w[], WORD k) {
+    WORD f[SHA1_MB_LANES];
+    sha1_mb_ch(f, s->b, s->c, s->d);
+    sha1_mb_round(r, s, f, w, k);
+}
+
+__attribute__((noinline))
+void sha1_mb_round_parity(SHA1_MB_STATE *r, const SHA1_MB_STATE *s, const WORD w[], WORD k) {
+    WORD f[SHA1_MB_LANES];
+    sha1_mb_parity(f, s->b, s->c, s->d);
+    sha1_mb_round(r, s, f, w, k);
+}
+
+__attribute__((noinline))
+void sha1_mb_round_maj(SHA1_MB_STATE *r, const SHA1_MB_STATE *s, const WORD w[], WORD k) {
+    WORD f[SHA1_MB_LANES];
+    sha1_mb_maj(f, s->b, s->c, s->d);
+    sha1_mb_round(r, s, f, w, k);
+}
+
+/************************* LANE SCHEDULE ****************************/
+
+// w[i][lane] = m[i] of lane's block, i < 16
+__attribute__((noinline))
+void sha1_mb_schedule_load(const BYTE *data[], WORD w[16][SHA1_MB_LANES]) {
+    int i, l;
+    for (i = 0; i < 16; ++i)
+        for (l = 0; l < SHA1_MB_LANES; ++l)
+            w[i][l] = ((WORD)data[l][4 * i] << 24) + ((WORD)data[l][4 * i + 1] << 16) +
+                      ((WORD)data[l][4 * i + 2] << 8) + ((WORD)data[l][4 * i + 3]);
+}
+
+// Same ring update as sha1_schedule_next (sha1_rolling.c), on every lane
+__attribute__((noinline))
+void sha1_mb_schedule_next(WORD w[16][SHA1_MB_LANES], int t) {
+    WORD x;
+    int l;
+    for (l = 0; l < SHA1_MB_LANES; ++l) {
+        x = w[(t - 3) & 15][l] ^ w[(t - 8) & 15][l] ^ w[(t - 14) & 15][l] ^ w[t & 15][l];
+        w[t & 15][l] = (x << 1) | (x >> 31);
+    }
+}
+
+/************************ LANE TRANSFORM ****************************/
+
+// h[j][lane] = state word j of lane; data[lane] = lane's 64-byte block
+__attribute__((noinline))
+void sha1_mb_transform(WORD h[5][SHA1_MB_LANES], const BYTE *data[], const WORD k[4]) {
+    WORD w[16][SHA1_MB_LANES];
+    SHA1_MB_STATE s, tmp;
+    int i, l;
+
+    sha1_mb_schedule_load(data, w);
+
+    for (l = 0; l < SHA1_MB_LANES; ++l) {
+        s.a[l] = h[0][l];
+        s.b[l] = h[1][l];
+        s.c[l] = h[2][l];
+        s.d[l] = h[3][l];
+        s.e[l] = h[4][l];
+    }
+
+    for (i = 0; i < 80; ++i) {
+        if (i >= 16)
+            sha1_mb_schedule_next(w, i);
+        if (i < 20)
+            sha1_mb_round_ch(&tmp, &s, w[i & 15], k[0]);
+        else if (i < 40)
+            sha1_mb_round_parity(&tmp, &s, w[i & 15], k[1]);
+        else if (i < 60)
+            sha1_mb_round_maj(&tmp, &s, w[i & 15], k[2]);
+        else
+            sha1_mb_round_parity(&tmp, &s, w[i & 15], k[3]);
+        s = tmp;
+    }
+
+    for (l = 0; l < SHA1_MB_LANES; ++l) {
+        h[0][l] += s.a[l];
+        h[1][l] += s.b[l];
+        h[2][l] += s.c[l];
+        h[3][l] += s.d[l];
+        h[4][l] += s.e[l];
+    }
+}
+
+/********************** MULTI-MESSAGE DRIVER ************************/
+
+// Block b of message (msg, len) after SHA-1 padding; returns 0 past the end
+static int sha1_mb_block(const BYTE msg[], size_t len, size_t b, BYTE out[64]) {
+    size_t nblocks = (len + 8) / 64 + 1;
+    unsigned long long bitlen = (unsigned long long)len * 8;
+    size_t i, pos;
+
+    if (b >= nblocks)
+        return 0;
+    for (i = 0; i < 64; ++i) {
+        pos = 64 * b + i;
+        if (pos < len)
+            out[i] = msg[pos];
+        else if (pos == len)
+            out[i] = 0x80;
+        else if (i >= 56 && b == nblocks - 1)
+            out[i] = (BYTE)(bitlen >> (8 * (63 - i)));
+        else
+            out[i] = 0x00;
+    }
+    return 1;
+}
+
+void sha1_mb_hash(const BYTE *msg[], const size_t len[], int nmsg,
+                  BYTE hash[][SHA1_BLOCK_SIZE]) {
+    static const WORD h0[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xc3d2e1f0 };
+    static const WORD k[4] = { 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6 };
+    BYTE blocks[SHA1_MB_LANES][64];
+    const BYTE *data[SHA1_MB_LANES];
+    WORD h[5][SHA1_MB_LANES], saved[5][SHA1_MB_LANES];
+    int live[SHA1_MB_LANES], any, l, j, i;
+    size_t b;
+
+    // Idle lanes (l >= nmsg) are never filled but still go through
+    // sha1_mb_transform: give them a defined block
+    memset(blocks, 0, sizeof(blocks));
+    for (l = 0; l < SHA1_MB_LANES; ++l) {
+        for (j = 0; j < 5; ++j)
+            h[j][l] = h0[j];
+        data[l] = blocks[l];
+    }
+
+    for (b = 0; ; ++b) {
+        any = 0;
+        for (l = 0; l < SHA1_MB_LANES; ++l) {
+            live[l] = l < nmsg && sha1_mb_block(msg[l], len[l], b, blocks[l]);
+            any |= live[l];
+        }
+        if (!any)
+            break;
+        // Finished lanes ride along and are restored afterwards
+        memcpy(saved, h, sizeof(h));
+        sha1_mb_transform(h, data, k);
+        for (l = 0; l < SHA1_MB_LANES; ++l)
+            if (!live[l])
+                for (j = 0; j < 5; ++j)
+                    h[j][l] = saved[j][l];
+    }
+
+    for (l = 0; l < nmsg && l < SHA1_MB_LANES; ++l)
+        for (j = 0; j < 5; ++j)
+            for (i = 0; i < 4; ++i)
+                hash[l][4 * j + i] = (BYTE)(h[j][l] >> (24 - 8 * i));
+}
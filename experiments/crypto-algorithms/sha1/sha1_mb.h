@@ -0,0 +1,34 @@
+/*********************************************************************
+* Filename:   sha1_mb.h
+* Purpose:    Multi-buffer SHA-1 (sha1_mb.c) and SHA-NI transform (sha1_ni.c)
+*********************************************************************/
+
+#ifndef SHA1_MB_H
+#define SHA1_MB_H
+
+#include "sha1.h"
+
+// 4 lanes = one 128-bit vector of WORDs; 8 suits AVX2. Only the 4-lane
+// build is verified (sha1_verify_mb.saw, make verify-mb); other widths
+// (e.g. -DSHA1_MB_LANES=8) are not
+#ifndef SHA1_MB_LANES
+#define SHA1_MB_LANES 4
+#endif
+
+// Lane-major round state: a[lane], ..., e[lane]
+typedef struct {
+    WORD a[SHA1_MB_LANES], b[SHA1_MB_LANES], c[SHA1_MB_LANES],
+         d[SHA1_MB_LANES], e[SHA1_MB_LANES];
+} SHA1_MB_STATE;
+
+// One 64-byte block per lane; h[j][lane] is state word j of that lane
+void sha1_mb_transform(WORD h[5][SHA1_MB_LANES], const BYTE *data[], const WORD k[4]);
+
+// Full SHA-1 of up to SHA1_MB_LANES messages of any lengths
+void sha1_mb_hash(const BYTE *msg[], const size_t len[], int nmsg,
+                  BYTE hash[][SHA1_BLOCK_SIZE]);
+
+// Drop-in sha1_transform using the x86 SHA extensions
+void sha1_transform_ni(SHA1_CTX *ctx, const BYTE data[]);
+
+#endif   // SHA1_MB_H
@@ -0,0 +1,124 @@
+/*********************************************************************
+* Filename:   sha1_ni.c
+* Purpose:    Single-stream SHA-1 transform using the x86 SHA extensions
+*
+* Key insight: as with aes_ni.c, SAW cannot execute SHA1RNDS4/SHA1MSG1/
+* SHA1MSG2, but each is a fixed composition of the scalar SHA-1 steps:
+*
+*   SHA1RNDS4 f  = 4 x sha1_round_<f>, K chosen by the immediate
+*   SHA1MSG1/2   = the m[t-16] ^ m[t-14] / ^ m[t-3], <<< 1 halves of the
+*                  schedule recurrence, 4 words at a time
+*
+* Each instruction sits in a noinline wrapper with a LOGICAL interface
+* (w[0] is the first word, st[] is a..e) so the dword reversal of the
+* ISA stays inside the wrapper. sha1_verify_ni.saw assumes the wrappers
+* (the modelled ISA semantics) and verifies the glue below against the
+* same compress80 . schedule80 spec as sha1_transform.
+*
+* SHA1RNDS4 has no E input/output: the wrapper adds E into W0 (what
+* SHA1NEXTE does) and returns E' = a <<< 30, the value E has after any
+* four rounds. The round constants are built into the instruction, so
+* sha1_transform_ni requires ctx->k to hold the standard constants,
+* which sha1_init sets.
+*
+* Build: needs an x86-64 target with -msha (see Makefile).
+*********************************************************************/
+
+#include <immintrin.h>
+#include "sha1.h"
+#include "sha1_mb.h"
+
+#define ROTLEFT(a, b) ((a << b) | (a >> (32 - b)))
+
+/*
+ * =============================================================================
+ * Instruction wrappers (assumed in sha1_verify_ni.saw)
+ * =============================================================================
+ */
+
+static __m128i sha1ni_load(const WORD w[4]) {
+    return _mm_set_epi32((int)w[0], (int)w[1], (int)w[2], (int)w[3]);
+}
+
+static void sha1ni_store(WORD w[4], __m128i v) {
+    WORD t[4];
+    _mm_storeu_si128((__m128i *)t, v);
+    w[0] = t[3];
+    w[1] = t[2];
+    w[2] = t[1];
+    w[3] = t[0];
+}
+
+// Four rounds: st = a..e, w = the four message words
+#define SHA1NI_RNDS4_BODY(F)                                               \
+    WORD e4 = ROTLEFT(st[0], 30);                                          \
+    __m128i abcd = sha1ni_load(st);                                        \
+    __m128i we = _mm_set_epi32((int)(w[0] + st[4]), (int)w[1], (int)w[2], (int)w[3]); \
+    sha1ni_store(st, _mm_sha1rnds4_epu32(abcd, we, F));                    \
+    st[4] = e4
+
+__attribute__((noinline))
+void sha1ni_rnds4_ch(WORD st[5], const WORD w[4]) { SHA1NI_RNDS4_BODY(0); }
+
+__attribute__((noinline))
+void sha1ni_rnds4_parity1(WORD st[5], const WORD w[4]) { SHA1NI_RNDS4_BODY(1); }
+
+__attribute__((noinline))
+void sha1ni_rnds4_maj(WORD st[5], const WORD w[4]) { SHA1NI_RNDS4_BODY(2); }
+
+__attribute__((noinline))
+void sha1ni_rnds4_parity3(WORD st[5], const WORD w[4]) { SHA1NI_RNDS4_BODY(3); }
+
+// out = [a2^a0, a3^a1, b0^a2, b1^a3]
+__attribute__((noinline))
+void sha1ni_msg1(WORD out[4], const WORD a[4], const WORD b[4]) {
+    sha1ni_store(out, _mm_sha1msg1_epu32(sha1ni_load(a), sha1ni_load(b)));
+}
+
+// out0 = (x0^b1)<<<1, out1 = (x1^b2)<<<1, out2 = (x2^b3)<<<1, out3 = (x3^out0)<<<1
+__attribute__((noinline))
+void sha1ni_msg2(WORD out[4], const WORD x[4], const WORD b[4]) {
+    sha1ni_store(out, _mm_sha1msg2_epu32(sha1ni_load(x), sha1ni_load(b)));
+}
+
+/*
+ * =============================================================================
+ * Plain C glue (verified, not assumed)
+ * =============================================================================
+ */
+
+void sha1_transform_ni(SHA1_CTX *ctx, const BYTE data[]) {
+    WORD st[5], q[4][4], x[4];
+    int g, i;
+
+    for (i = 0; i < 5; ++i)
+        st[i] = ctx->state[i];
+
+    // Group g = rounds 4g .. 4g+3; q[g mod 4] holds m[4g .. 4g+3]
+    for (g = 0; g < 20; ++g) {
+        if (g < 4) {
+            for (i = 0; i < 4; ++i)
+                q[g][i] = ((WORD)data[16 * g + 4 * i] << 24) +
+                          ((WORD)data[16 * g + 4 * i + 1] << 16) +
+                          ((WORD)data[16 * g + 4 * i + 2] << 8) +
+                          ((WORD)data[16 * g + 4 * i + 3]);
+        } else {
+            sha1ni_msg1(x, q[g & 3], q[(g + 1) & 3]);
+            for (i = 0; i < 4; ++i)
+                x[i] ^= q[(g + 2) & 3][i];
+            sha1ni_msg2(q[g & 3], x, q[(g + 3) & 3]);
+        }
+
+        if (g < 5)
+            sha1ni_rnds4_ch(st, q[g & 3]);
+        else if (g < 10)
+            sha1ni_rnds4_parity1(st, q[g & 3]);
+        else if (g < 15)
+            sha1ni_rnds4_maj(st, q[g & 3]);
+        else
+            sha1ni_rnds4_parity3(st, q[g & 3]);
+    }
+
+    for (i = 0; i < 5; ++i)
+        ctx->state[i] += st[i];
+}
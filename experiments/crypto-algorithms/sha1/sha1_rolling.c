@@ -0,0 +1,86 @@
+/*********************************************************************
+* Filename:   sha1_rolling.c
+* Purpose:    SHA-1 transform with a 16-word rolling message schedule
+*
+* Key insight: m[t] only depends on m[t-3], m[t-8], m[t-14], m[t-16],
+* so a 16-word ring holding m[t-16 .. t-1] is enough. Slot t mod 16
+* holds m[t-16], which is the last use of that word, so m[t] overwrites
+* it in place. Each word is computed right before the round that uses
+* it: 64 bytes of schedule state instead of 320.
+*
+* The round functions are the verified sha1_round_ch/parity/maj from
+* sha1_single_round.c (included unchanged), so sha1_verify_schedule.saw
+* reuses the same round-level specs as overrides.
+*********************************************************************/
+
+#include "sha1_single_round.c"
+
+/*********************** ROLLING SCHEDULE ***************************/
+
+// w[0..15] = m[0..15], big-endian words of the block
+__attribute__((noinline))
+void sha1_schedule_load(const BYTE data[], WORD w[16]) {
+    int i;
+    for (i = 0; i < 16; ++i)
+        w[i] = ((WORD)data[4 * i] << 24) + ((WORD)data[4 * i + 1] << 16) +
+               ((WORD)data[4 * i + 2] << 8) + ((WORD)data[4 * i + 3]);
+}
+
+// m[t] for 16 <= t < 80, given w[j mod 16] = m[j] for t-16 <= j < t.
+// The result replaces m[t-16] in slot t mod 16.
+__attribute__((noinline))
+WORD sha1_schedule_next(WORD w[16], int t) {
+    WORD x = w[(t - 3) & 15] ^ w[(t - 8) & 15] ^ w[(t - 14) & 15] ^ w[t & 15];
+    x = (x << 1) | (x >> 31);
+    w[t & 15] = x;
+    return x;
+}
+
+#define SHA1_W(w, t) ((t) < 16 ? (w)[t] : sha1_schedule_next(w, t))
+
+/*********************** ROLLING TRANSFORM **************************/
+
+__attribute__((noinline))
+void sha1_transform_rolling(SHA1_CTX *ctx, const BYTE data[]) {
+    WORD w[16];
+    SHA1_STATE s, tmp;
+    int i;
+
+    sha1_schedule_load(data, w);
+
+    s.a = ctx->state[0];
+    s.b = ctx->state[1];
+    s.c = ctx->state[2];
+    s.d = ctx->state[3];
+    s.e = ctx->state[4];
+
+    // Rounds 0-19: Ch
+    for (i = 0; i < 20; ++i) {
+        sha1_round_ch(&tmp, &s, SHA1_W(w, i), ctx->k[0]);
+        s = tmp;
+    }
+
+    // Rounds 20-39: Parity
+    for (i = 20; i < 40; ++i) {
+        sha1_round_parity(&tmp, &s, SHA1_W(w, i), ctx->k[1]);
+        s = tmp;
+    }
+
+    // Rounds 40-59: Maj
+    for (i = 40; i < 60; ++i) {
+        sha1_round_maj(&tmp, &s, SHA1_W(w, i), ctx->k[2]);
+        s = tmp;
+    }
+
+    // Rounds 60-79: Parity
+    for (i = 60; i < 80; ++i) {
+        sha1_round_parity(&tmp, &s, SHA1_W(w, i), ctx->k[3]);
+        s = tmp;
+    }
+
+    ctx->state[0] += s.a;
+    ctx->state[1] += s.b;
+    ctx->state[2] += s.c;
+    ctx->state[3] += s.d;
+    ctx->state[4] += s.e;
+}
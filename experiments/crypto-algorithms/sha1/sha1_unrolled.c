@@ -0,0 +1,86 @@
+/*********************************************************************
+* Filename:   sha1_unrolled.c
+* Purpose:    Fully unrolled, register-resident SHA-1 transform
+*
+* Key insight: a round only writes a (new value) and c (b <<< 30); the
+* other three words just move one place. Rotating the variable NAMES
+* instead of the values removes the SHA1_STATE struct copies, and with
+* the round body inlined the 80 rounds become straight-line code on five
+* locals.
+*
+* Each round adds in the same order as sha1_round_ch/parity/maj
+* (rotl(a,5) + f(b,c,d) + e + k + w), so after symbolic execution every
+* round is structurally the spec round. The production build expands the
+* Boolean functions inline. sha1_verify_unrolled.saw verifies both builds
+* against the same spec: sha1_unrolled.bc with -DSHA1_PRIM_CALLS, where
+* they become calls to the verified sha1_ch/parity/maj (same expressions,
+* from sha1_single_round.c, included unchanged) kept uninterpreted, and
+* the production build sha1_unrolled_prod.bc bit-level.
+*********************************************************************/
+
+#include "sha1_single_round.c"
+
+/************************ BOOLEAN FUNCTIONS *************************/
+
+#ifdef SHA1_PRIM_CALLS
+#define SHA1_F_CH(b, c, d)     sha1_ch(b, c, d)
+#define SHA1_F_PARITY(b, c, d) sha1_parity(b, c, d)
+#define SHA1_F_MAJ(b, c, d)    sha1_maj(b, c, d)
+#else
+#define SHA1_F_CH(b, c, d)     (((b) & (c)) ^ (~(b) & (d)))
+#define SHA1_F_PARITY(b, c, d) ((b) ^ (c) ^ (d))
+#define SHA1_F_MAJ(b, c, d)    (((b) & (c)) ^ ((b) & (d)) ^ ((c) & (d)))
+#endif
+
+/************************** UNROLLED ROUNDS *************************/
+
+// One round on named registers: e takes the new a, b takes b <<< 30.
+// The next round is called with the names shifted by one.
+#define SHA1_ROUND(F, a, b, c, d, e, w, k) do { \
+    e = ROTLEFT(a, 5) + F(b, c, d) + e + (k) + (w); \
+    b = ROTLEFT(b, 30); \
+} while (0)
+
+// Five rounds bring the names back to their starting positions
+#define SHA1_ROUND5(F, m, i, k) do { \
+    SHA1_ROUND(F, a, b, c, d, e, (m)[(i)],     k); \
+    SHA1_ROUND(F, e, a, b, c, d, (m)[(i) + 1], k); \
+    SHA1_ROUND(F, d, e, a, b, c, (m)[(i) + 2], k); \
+    SHA1_ROUND(F, c, d, e, a, b, (m)[(i) + 3], k); \
+    SHA1_ROUND(F, b, c, d, e, a, (m)[(i) + 4], k); \
+} while (0)
+
+#define SHA1_ROUND20(F, m, i, k) do { \
+    SHA1_ROUND5(F, m, (i),      k); \
+    SHA1_ROUND5(F, m, (i) + 5,  k); \
+    SHA1_ROUND5(F, m, (i) + 10, k); \
+    SHA1_ROUND5(F, m, (i) + 15, k); \
+} while (0)
+
+/*********************** UNROLLED TRANSFORM *************************/
+
+__attribute__((noinline))
+void sha1_transform_unrolled(SHA1_CTX *ctx, const BYTE data[]) {
+    WORD m[80];
+    WORD a, b, c, d, e;
+    WORD k0 = ctx->k[0], k1 = ctx->k[1], k2 = ctx->k[2], k3 = ctx->k[3];
+
+    sha1_message_schedule(data, m);
+
+    a = ctx->state[0];
+    b = ctx->state[1];
+    c = ctx->state[2];
+    d = ctx->state[3];
+    e = ctx->state[4];
+
+    SHA1_ROUND20(SHA1_F_CH,     m, 0,  k0);
+    SHA1_ROUND20(SHA1_F_PARITY, m, 20, k1);
+    SHA1_ROUND20(SHA1_F_MAJ,    m, 40, k2);
+    SHA1_ROUND20(SHA1_F_PARITY, m, 60, k3);
+
+    ctx->state[0] += a;
+    ctx->state[1] += b;
+    ctx->state[2] += c;
+    ctx->state[3] += d;
+    ctx->state[4] += e;
+}
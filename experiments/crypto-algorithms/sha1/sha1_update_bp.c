@@ -0,0 +1,42 @@
+/*********************************************************************
+* Filename:   sha1_update_bp.c
+* Purpose:    sha1_update with a loop-invariant breakpoint
+*
+* Key insight: every iteration of sha1_update does the same bookkeeping
+* (buffer one byte, maybe run sha1_transform), so the loop can be proved
+* ONCE from an arbitrary iteration with a __breakpoint__ invariant (the
+* technique from experiments/hello-saw/loop_invariant.c, as in
+* aes/aes_bulk.c). With sha1_transform as an override the proof never
+* unrolls the loop, so len can be symbolic.
+*
+* sha1_update_bp is sha1_update from sha1_single_round.c line for line,
+* with the breakpoint call at the loop head. The breakpoint only exists
+* in the SAW bitcode (-DSAW_BREAKPOINTS); native builds compile it away.
+* Every live variable at the loop head is passed to it.
+*
+* Includes sha1_single_round.c unchanged, so sha1_transform and
+* sha1_final are the functions verified elsewhere.
+*********************************************************************/
+
+#include "sha1_single_round.c"
+
+#ifdef SAW_BREAKPOINTS
+extern void __breakpoint__update_inv(SHA1_CTX **, const BYTE **, size_t *, size_t *)
+    __attribute__((noduplicate));
+#define UPDATE_INV(...) __breakpoint__update_inv(__VA_ARGS__)
+#else
+#define UPDATE_INV(...) ((void)0)
+#endif
+
+void sha1_update_bp(SHA1_CTX *ctx, const BYTE data[], size_t len) {
+    size_t i;
+    for (i = 0; UPDATE_INV(&ctx, &data, &len, &i), i < len; ++i) {
+        ctx->data[ctx->datalen] = data[i];
+        ctx->datalen++;
+        if (ctx->datalen == 64) {
+            sha1_transform(ctx, ctx->data);
+            ctx->bitlen += 512;
+            ctx->datalen = 0;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*********************************************************************
+* Filename:   sha1_update_fast.c
+* Purpose:    Multi-block sha1_update fast path
+*
+* Key insight: sha1_update copies every byte into ctx->data, even when
+* the caller's buffer already holds whole 64-byte blocks. The fast path
+* only buffers a partial head/tail and runs sha1_transform directly on
+* whole blocks in the caller's buffer.
+*
+* The resulting SHA1_CTX is byte-for-byte the one sha1_update produces
+* (including the stale bytes past datalen, see the memcpy below), so the
+* two functions are interchangeable mid-stream. sha1_verify_update_fast.saw
+* proves both against the same byte-at-a-time Cryptol model.
+*
+* Includes sha1_single_round.c unchanged so both functions share the same
+* sha1_transform.
+*********************************************************************/
+
+#include "sha1_single_round.c"
+
+void sha1_update_fast(SHA1_CTX *ctx, const BYTE data[], size_t len) {
+    size_t i = 0;
+
+    // Top up a partially filled buffer exactly like sha1_update
+    while (ctx->datalen != 0 && i < len) {
+        ctx->data[ctx->datalen] = data[i];
+        ctx->datalen++;
+        i++;
+        if (ctx->datalen == 64) {
+            sha1_transform(ctx, ctx->data);
+            ctx->bitlen += 512;
+            ctx->datalen = 0;
+        }
+    }
+
+    // Whole blocks straight from the caller's buffer
+    if (len - i >= 64) {
+        for ( ; len - i >= 64; i += 64) {
+            sha1_transform(ctx, &data[i]);
+            ctx->bitlen += 512;
+        }
+        // sha1_update leaves the last full block in ctx->data; do the same
+        // (one 64-byte copy per call, not per block)
+        memcpy(ctx->data, &data[i - 64], 64);
+    }
+
+    // Buffer the tail (datalen is 0 here unless all input went to the head)
+    for ( ; i < len; ++i) {
+        ctx->data[ctx->datalen] = data[i];
+        ctx->datalen++;
+    }
+}
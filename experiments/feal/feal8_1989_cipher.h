@@ -0,0 +1,119 @@
+/*
+ * FEAL-8 1989 cipher structure, written once for every variant
+ *
+ * SetKey (the FK key schedule) and the Encrypt/Decrypt Feistel network of
+ * feal8_1989_portable.c, over the primitives and key storage the including
+ * variant names. feal8_1989_rot2.c, feal8_1989_ctx.c and feal8_1989_fast.c
+ * each define the macros below and include this file once; it has no
+ * include guard and undefines them at the end.
+ *
+ *   FEAL_NAME(name)     the variant's function name, e.g. name##_pure
+ *   FEAL_KEY_OUT        leading key parameter of SetKey (empty or
+ *                       "FEAL_KEY *Key,")
+ *   FEAL_KEY_IN         leading key parameter of Encrypt/Decrypt (empty
+ *                       or "const FEAL_KEY *Key,")
+ *   FEAL_KEY_FIELD(x)   the schedule entry x (K, K89, ...): x or Key->x
+ *   FEAL_F, FEAL_FK     round and key-schedule functions
+ *   FEAL_MAKEH1         HalfWord from four bytes, little-endian
+ *   FEAL_MAKEH2         HalfWord from two QuarterWords (low 16 bits each)
+ *   FEAL_DISSH1         four bytes from a HalfWord, little-endian
+ *
+ * SetKey takes the low and high 16 bits of each new B as the subkeys.
+ * The original does the same through a union of B and Q, which on the
+ * little-endian hosts feal8_1989_portable.c runs on is the same value.
+ */
+
+void FEAL_NAME(SetKey)(FEAL_KEY_OUT ByteType *KP)
+/*
+     As SetKey, with FEAL_FK, into the variant's key storage.
+*/
+{
+    HalfWord A, B, D, NewB;
+    int i;
+
+    A = FEAL_MAKEH1(KP);
+    B = FEAL_MAKEH1(KP + 4);
+    D = 0;
+
+    for (i = 0; i < 8; ++i)
+    {
+        NewB = FEAL_FK(A, B ^ D);
+        D = A;
+        A = B;
+        B = NewB;
+        FEAL_KEY_FIELD(K)[2 * i] = (QuarterWord)(B & 0xffff);
+        FEAL_KEY_FIELD(K)[2 * i + 1] = (QuarterWord)((B >> 16) & 0xffff);
+    }
+    FEAL_KEY_FIELD(K89) = FEAL_MAKEH2(FEAL_KEY_FIELD(K) + 8);
+    FEAL_KEY_FIELD(K1011) = FEAL_MAKEH2(FEAL_KEY_FIELD(K) + 10);
+    FEAL_KEY_FIELD(K1213) = FEAL_MAKEH2(FEAL_KEY_FIELD(K) + 12);
+    FEAL_KEY_FIELD(K1415) = FEAL_MAKEH2(FEAL_KEY_FIELD(K) + 14);
+}
+
+void FEAL_NAME(Encrypt)(FEAL_KEY_IN ByteType *Plain, ByteType *Cipher)
+/*
+     As Encrypt, with FEAL_F, from the variant's key storage.
+*/
+{
+    HalfWord L, R, NewR;
+    int r;
+
+    L = FEAL_MAKEH1(Plain);
+    R = FEAL_MAKEH1(Plain + 4);
+    L ^= FEAL_KEY_FIELD(K89);
+    R ^= FEAL_KEY_FIELD(K1011);
+    R ^= L;
+
+    for (r = 0; r < 8; ++r)
+    {
+        NewR = L ^ FEAL_F(R, FEAL_KEY_FIELD(K)[r]);
+        L = R;
+        R = NewR;
+    }
+
+    L ^= R;
+    R ^= FEAL_KEY_FIELD(K1213);
+    L ^= FEAL_KEY_FIELD(K1415);
+
+    FEAL_DISSH1(R, Cipher);
+    FEAL_DISSH1(L, Cipher + 4);
+}
+
+void FEAL_NAME(Decrypt)(FEAL_KEY_IN ByteType *Cipher, ByteType *Plain)
+/*
+     As Decrypt, with FEAL_F, from the variant's key storage.
+*/
+{
+    HalfWord L, R, NewL;
+    int r;
+
+    R = FEAL_MAKEH1(Cipher);
+    L = FEAL_MAKEH1(Cipher + 4);
+    R ^= FEAL_KEY_FIELD(K1213);
+    L ^= FEAL_KEY_FIELD(K1415);
+    L ^= R;
+
+    for (r = 7; r >= 0; --r)
+    {
+        NewL = R ^ FEAL_F(L, FEAL_KEY_FIELD(K)[r]);
+        R = L;
+        L = NewL;
+    }
+
+    R ^= L;
+    R ^= FEAL_KEY_FIELD(K1011);
+    L ^= FEAL_KEY_FIELD(K89);
+
+    FEAL_DISSH1(L, Plain);
+    FEAL_DISSH1(R, Plain + 4);
+}
+
+#undef FEAL_NAME
+#undef FEAL_KEY_OUT
+#undef FEAL_KEY_IN
+#undef FEAL_KEY_FIELD
+#undef FEAL_F
+#undef FEAL_FK
+#undef FEAL_MAKEH1
+#undef FEAL_MAKEH2
+#undef FEAL_DISSH1
@@ -0,0 +1,39 @@
+/*
+ * FEAL-8 1989 Implementation - Re-entrant Key Context Variant
+ *
+ * SetKey writes the expanded key into globals (K[16], K89, K1011, K1213,
+ * K1415) and Encrypt/Decrypt read "the last key set", so a process can
+ * only use one key at a time. The _ctx functions below take the same
+ * schedule in a caller-owned FEAL_KEY instead: any number of keys can be
+ * live, and threads can encrypt under different keys concurrently.
+ *
+ * They are the cipher structure of feal8_1989_cipher.h, as SetKey_pure/
+ * Encrypt_pure/Decrypt_pure are, on the same primitives (f_pure/FK_pure
+ * and the union helpers, feal8_1989_rot2.c and the 1989 source it
+ * includes) with every global access replaced by the matching FEAL_KEY
+ * field. No global is read or written.
+ *
+ * Verification: feal8_1989_ctx_verify.saw proves SetKey_ctx/Encrypt_ctx/
+ * Decrypt_ctx against the same specs as the global-state versions, with
+ * the schedule location as the only parameter.
+ */
+
+#include "feal8_1989_rot2.c"
+
+/* Expanded key: same types and layout as the 1989 globals */
+typedef struct {
+    QuarterWord K[16];
+    HalfWord K89, K1011, K1213, K1415;
+} FEAL_KEY;
+
+/* SetKey_ctx, Encrypt_ctx, Decrypt_ctx: rot2's primitives, *Key */
+#define FEAL_NAME(name) name##_ctx
+#define FEAL_KEY_OUT FEAL_KEY *Key,
+#define FEAL_KEY_IN const FEAL_KEY *Key,
+#define FEAL_KEY_FIELD(x) Key->x
+#define FEAL_F f_pure
+#define FEAL_FK FK_pure
+#define FEAL_MAKEH1 MakeH1
+#define FEAL_MAKEH2 MakeH2
+#define FEAL_DISSH1 DissH1
+#include "feal8_1989_cipher.h"
@@ -0,0 +1,84 @@
+/*
+ * Native test for feal8_1989_ctx.c
+ *
+ * 1. SetKey_ctx fills a FEAL_KEY with exactly the globals SetKey writes.
+ * 2. Threads encrypt under DIFFERENT keys at the same time with
+ *    Encrypt_ctx/Decrypt_ctx and must reproduce single-threaded
+ *    SetKey + Encrypt results.
+ *
+ * Run: make test-ctx
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "feal8_1989_ctx.c"
+
+#define NTHREADS 4
+#define NBLOCKS 1024
+
+static FEAL_KEY keys[NTHREADS];
+static ByteType plain[NBLOCKS][8];
+static ByteType expect[NTHREADS][NBLOCKS][8];
+static int thread_failures[NTHREADS];
+
+static void *worker(void *arg)
+{
+    int id = (int)(long)arg;
+    ByteType c[8], p[8];
+    int i, pass;
+
+    for (pass = 0; pass < 16; pass++)
+        for (i = 0; i < NBLOCKS; i++) {
+            Encrypt_ctx(&keys[id], plain[i], c);
+            Decrypt_ctx(&keys[id], c, p);
+            if (memcmp(c, expect[id][i], 8) != 0 || memcmp(p, plain[i], 8) != 0)
+                thread_failures[id]++;
+        }
+    return NULL;
+}
+
+int main(void)
+{
+    ByteType key[8];
+    FEAL_KEY ks;
+    pthread_t th[NTHREADS];
+    int i, j, t, failures = 0;
+
+    srand(1);
+    for (i = 0; i < 1000; i++) {
+        for (j = 0; j < 8; j++)
+            key[j] = (ByteType)rand();
+        SetKey(key);
+        SetKey_ctx(&ks, key);
+        if (memcmp(ks.K, K, sizeof(K)) != 0 || ks.K89 != K89 ||
+            ks.K1011 != K1011 || ks.K1213 != K1213 || ks.K1415 != K1415)
+            failures++;
+    }
+
+    for (i = 0; i < NBLOCKS; i++)
+        for (j = 0; j < 8; j++)
+            plain[i][j] = (ByteType)rand();
+    for (t = 0; t < NTHREADS; t++) {
+        for (j = 0; j < 8; j++)
+            key[j] = (ByteType)rand();
+        SetKey(key);
+        SetKey_ctx(&keys[t], key);
+        for (i = 0; i < NBLOCKS; i++)
+            Encrypt(plain[i], expect[t][i]);
+    }
+
+    for (t = 0; t < NTHREADS; t++)
+        pthread_create(&th[t], NULL, worker, (void *)(long)t);
+    for (t = 0; t < NTHREADS; t++) {
+        pthread_join(th[t], NULL);
+        failures += thread_failures[t];
+    }
+
+    if (failures) {
+        printf("feal8_1989_ctx: %d failures\n", failures);
+        return 1;
+    }
+    printf("feal8_1989_ctx: SetKey_ctx, per-thread-key Encrypt_ctx/Decrypt_ctx passed\n");
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * FEAL-8 1989 Implementation - Union-free Word-arithmetic Variant
+ *
+ * MakeH1, DissH1, f and FK move every value through a
+ * { unsigned long All; ByteType Byte[4]; } union: on LP64 that is a
+ * zero-initialized 8-byte stack slot, byte stores and a reload per call,
+ * and the result depends on host byte order.
+ *
+ * The _fast functions below compute the same little-endian values with
+ * shifts and masks, so everything stays in registers and the code is
+ * endian-independent:
+ *
+ *   Byte[i] of a HalfWord H   ==  (H >> 8*i) & 0xff
+ *   All from Byte[0..3]       ==  B0 | B1 << 8 | B2 << 16 | B3 << 24
+ *
+ * S-boxes are the table-free S0_pure/S1_pure (feal8_1989_rot2.c) and the
+ * key schedule is a caller-owned FEAL_KEY (feal8_1989_ctx.c), both
+ * included with the 1989 source. SetKey_fast/Encrypt_fast/Decrypt_fast
+ * are the cipher structure of feal8_1989_cipher.h over these helpers.
+ *
+ * Verification: feal8_1989_fast_verify.saw proves each _fast function
+ * against the same Cryptol spec as its union-based original.
+ */
+
+#include "feal8_1989_ctx.c"
+
+#define FEAL_BYTE(H, i) ((ByteType)((H) >> (8 * (i))))
+
+HalfWord MakeH1_fast(ByteType *B)
+/*
+     As MakeH1: little-endian halfword from four bytes.
+*/
+{
+    return (HalfWord)B[0] | ((HalfWord)B[1] << 8) |
+           ((HalfWord)B[2] << 16) | ((HalfWord)B[3] << 24);
+}
+
+void DissH1_fast(HalfWord H, ByteType *D)
+/*
+     As DissH1: the four low bytes of H, least significant first.
+*/
+{
+    D[0] = FEAL_BYTE(H, 0);
+    D[1] = FEAL_BYTE(H, 1);
+    D[2] = FEAL_BYTE(H, 2);
+    D[3] = FEAL_BYTE(H, 3);
+}
+
+HalfWord f_fast(HalfWord AA, QuarterWord BB)
+/*
+     As f, on bytes extracted by shifting.
+*/
+{
+    ByteType a0 = FEAL_BYTE(AA, 0), a1 = FEAL_BYTE(AA, 1);
+    ByteType a2 = FEAL_BYTE(AA, 2), a3 = FEAL_BYTE(AA, 3);
+    ByteType f1, f2;
+
+    f1 = a1 ^ FEAL_BYTE(BB, 0) ^ a0;
+    f2 = a2 ^ FEAL_BYTE(BB, 1) ^ a3;
+    f1 = S1_pure(f1, f2);
+    f2 = S0_pure(f2, f1);
+    return (HalfWord)S0_pure(a0, f1) | ((HalfWord)f1 << 8) |
+           ((HalfWord)f2 << 16) | ((HalfWord)S1_pure(a3, f2) << 24);
+}
+
+HalfWord FK_fast(HalfWord AA, HalfWord BB)
+/*
+     As FK, on bytes extracted by shifting.
+*/
+{
+    ByteType a0 = FEAL_BYTE(AA, 0), a1 = FEAL_BYTE(AA, 1);
+    ByteType a2 = FEAL_BYTE(AA, 2), a3 = FEAL_BYTE(AA, 3);
+    ByteType FK1, FK2;
+
+    FK1 = a1 ^ a0;
+    FK2 = a2 ^ a3;
+    FK1 = S1_pure(FK1, FK2 ^ FEAL_BYTE(BB, 0));
+    FK2 = S0_pure(FK2, FK1 ^ FEAL_BYTE(BB, 1));
+    return (HalfWord)S0_pure(a0, FK1 ^ FEAL_BYTE(BB, 2)) | ((HalfWord)FK1 << 8) |
+           ((HalfWord)FK2 << 16) | ((HalfWord)S1_pure(a3, FK2 ^ FEAL_BYTE(BB, 3)) << 24);
+}
+
+HalfWord MakeH2_fast(QuarterWord *Q)
+/*
+     As MakeH2: the low 16 bits of Q[0], then those of Q[1].
+*/
+{
+    return (HalfWord)(Q[0] & 0xffff) | ((HalfWord)(Q[1] & 0xffff) << 16);
+}
+
+/* SetKey_fast, Encrypt_fast, Decrypt_fast: ctx's *Key, union-free helpers */
+#define FEAL_NAME(name) name##_fast
+#define FEAL_KEY_OUT FEAL_KEY *Key,
+#define FEAL_KEY_IN const FEAL_KEY *Key,
+#define FEAL_KEY_FIELD(x) Key->x
+#define FEAL_F f_fast
+#define FEAL_FK FK_fast
+#define FEAL_MAKEH1 MakeH1_fast
+#define FEAL_MAKEH2 MakeH2_fast
+#define FEAL_DISSH1 DissH1_fast
+#include "feal8_1989_cipher.h"
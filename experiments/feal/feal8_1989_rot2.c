@@ -0,0 +1,106 @@
+/*
+ * FEAL-8 1989 Implementation - Table-free Rot2 Variant
+ *
+ * The original Rot2 (feal8_1989_portable.c) builds a 256-entry table on
+ * first call, guarded by "static int First". That is a branch on every
+ * S0/S1 call and a data race when two threads encrypt at once.
+ *
+ * Rot2_pure is the 2-bit rotation itself: no static state, nothing to
+ * initialize, safe to call from any thread. S0/S1/f/FK below are the 1989
+ * functions unchanged except that they call it (suffix _pure).
+ * SetKey_pure/Encrypt_pure/Decrypt_pure are the cipher structure of
+ * feal8_1989_cipher.h over f_pure/FK_pure. The key schedule globals K,
+ * K89, ... and the union helpers MakeH1/MakeH2/DissH1 are the original
+ * ones, included from feal8_1989_portable.c.
+ *
+ * After SetKey_pure, Encrypt_pure/Decrypt_pure only READ global state, so
+ * any number of threads can encrypt under the same key without a lock.
+ *
+ * Verification: feal8_1989_rot2_verify.saw proves each _pure function
+ * against the same Cryptol spec as the original, without the Rot2.First /
+ * Rot2.RetVal preconditions.
+ */
+
+/* Original 1989 code; its test main() is renamed out of the way */
+#define main feal8_1989_selftest
+#include "feal8_1989_portable.c"
+#undef main
+
+ByteType Rot2_pure(ByteType X)
+{
+    return (ByteType)((X << 2) | (X >> 6));
+}
+
+ByteType S0_pure(ByteType X1, ByteType X2)
+{
+    return Rot2_pure((X1 + X2) & 0xff);
+}
+
+ByteType S1_pure(ByteType X1, ByteType X2)
+{
+    return Rot2_pure((X1 + X2 + 1) & 0xff);
+}
+
+HalfWord f_pure(HalfWord AA, QuarterWord BB)
+/*
+     Evaluate the f function (as f, with S0_pure/S1_pure).
+*/
+{
+    ByteType f1, f2;
+    union {
+        unsigned long All;
+        ByteType Byte[4];
+    } RetVal = {0}, A;
+    union {
+        unsigned int All;
+        ByteType Byte[2];
+    } B;
+
+    A.All = AA;
+    B.All = BB;
+    f1 = A.Byte[1] ^ B.Byte[0] ^ A.Byte[0];
+    f2 = A.Byte[2] ^ B.Byte[1] ^ A.Byte[3];
+    f1 = S1_pure(f1, f2);
+    f2 = S0_pure(f2, f1);
+    RetVal.Byte[1] = f1;
+    RetVal.Byte[2] = f2;
+    RetVal.Byte[0] = S0_pure(A.Byte[0], f1);
+    RetVal.Byte[3] = S1_pure(A.Byte[3], f2);
+    return RetVal.All;
+}
+
+HalfWord FK_pure(HalfWord AA, HalfWord BB)
+/*
+     Evaluate the FK function (as FK, with S0_pure/S1_pure).
+*/
+{
+    ByteType FK1, FK2;
+    union {
+        unsigned long All;
+        ByteType Byte[4];
+    } RetVal = {0}, A, B;
+
+    A.All = AA;
+    B.All = BB;
+    FK1 = A.Byte[1] ^ A.Byte[0];
+    FK2 = A.Byte[2] ^ A.Byte[3];
+    FK1 = S1_pure(FK1, FK2 ^ B.Byte[0]);
+    FK2 = S0_pure(FK2, FK1 ^ B.Byte[1]);
+    RetVal.Byte[1] = FK1;
+    RetVal.Byte[2] = FK2;
+    RetVal.Byte[0] = S0_pure(A.Byte[0], FK1 ^ B.Byte[2]);
+    RetVal.Byte[3] = S1_pure(A.Byte[3], FK2 ^ B.Byte[3]);
+    return RetVal.All;
+}
+
+/* SetKey_pure, Encrypt_pure, Decrypt_pure: the 1989 globals, union helpers */
+#define FEAL_NAME(name) name##_pure
+#define FEAL_KEY_OUT
+#define FEAL_KEY_IN
+#define FEAL_KEY_FIELD(x) x
+#define FEAL_F f_pure
+#define FEAL_FK FK_pure
+#define FEAL_MAKEH1 MakeH1
+#define FEAL_MAKEH2 MakeH2
+#define FEAL_DISSH1 DissH1
+#include "feal8_1989_cipher.h"
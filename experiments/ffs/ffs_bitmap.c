@@ -0,0 +1,38 @@
+#include <stddef.h>
+#include "ffs_ctz.c"
+
+// Bulk scanner for bitmap allocators: bit index of the first set bit in
+// map[0 .. nwords) (1-indexed, bit b of map[i] is 64*i + b + 1), 0 if the
+// whole bitmap is clear.
+//
+// Runs of clear words are skipped four at a time: the four words are
+// OR-ed and the result tested once (gcc -O2 on x86-64: a chain of scalar
+// orq and one branch per four words). Only the word holding the first set
+// bit goes through ffs64_ctz.
+//
+// The loop is proved once from an arbitrary i with a __breakpoint__
+// invariant (see experiments/hello-saw/loop_invariant.c); the breakpoint
+// only exists in the SAW bitcode (-DSAW_BREAKPOINTS).
+
+#ifdef SAW_BREAKPOINTS
+extern void __breakpoint__bitmap_inv(const uint64_t **, size_t *, size_t *)
+    __attribute__((noduplicate));
+#define BITMAP_INV(...) __breakpoint__bitmap_inv(__VA_ARGS__)
+#else
+#define BITMAP_INV(...) ((void)0)
+#endif
+
+size_t find_first_set_in_bitmap(const uint64_t *map, size_t nwords) {
+    size_t i;
+
+    for (i = 0; BITMAP_INV(&map, &nwords, &i), i < nwords; ) {
+        if (nwords - i >= 4 && (map[i] | map[i + 1] | map[i + 2] | map[i + 3]) == 0) {
+            i += 4;
+            continue;
+        }
+        if (map[i] != 0)
+            return 64 * i + ffs64_ctz(map[i]);
+        i++;
+    }
+    return 0;
+}
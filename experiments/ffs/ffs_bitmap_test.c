@@ -0,0 +1,46 @@
+// Native test for ffs_ctz.c / ffs_bitmap.c against ffs_ref
+// Run: make test-bitmap
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ffs_bitmap.c"
+
+static size_t bitmap_ref(const uint64_t *map, size_t nwords) {
+    for (size_t i = 0; i < nwords; i++) {
+        uint32_t lo = (uint32_t)map[i], hi = (uint32_t)(map[i] >> 32);
+        if (lo) return 64 * i + ffs_ref(lo);
+        if (hi) return 64 * i + 32 + ffs_ref(hi);
+    }
+    return 0;
+}
+
+int main(void) {
+    static uint64_t map[4096];
+    int failures = 0;
+
+    srand(1);
+    for (int t = 0; t < 1000000; t++) {
+        uint32_t x = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+        x &= (uint32_t)-1 << (rand() % 32);
+        if (ffs_ctz(x) != ffs_ref(x)) failures++;
+    }
+    if (ffs_ctz(0) != 0 || ffs64_ctz(0) != 0) failures++;
+
+    for (int t = 0; t < 2000; t++) {
+        size_t n = (size_t)(rand() % 4096);
+        for (size_t i = 0; i < n; i++) map[i] = 0;
+        if (n && rand() % 8) {
+            size_t at = (size_t)rand() % n;
+            map[at] = (uint64_t)1 << (rand() % 64);
+            if (at + 1 < n) map[at + 1] = ~(uint64_t)0;
+        }
+        if (find_first_set_in_bitmap(map, n) != bitmap_ref(map, n)) failures++;
+    }
+
+    if (failures) {
+        printf("ffs_bitmap: %d failures\n", failures);
+        return 1;
+    }
+    printf("ffs_bitmap: ffs_ctz and find_first_set_in_bitmap match ffs_ref\n");
+    return 0;
+}
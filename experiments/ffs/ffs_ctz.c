@@ -0,0 +1,17 @@
+#include "ffs.c"
+
+// Branch-free implementation using hardware count-trailing-zeros
+// (TZCNT/BSF on x86, RBIT+CLZ on ARM). Setting bit 31 keeps the
+// __builtin_ctz argument non-zero, so the result is always defined;
+// the mask turns x == 0 into 0 without a branch.
+uint32_t ffs_ctz(uint32_t x) {
+    uint32_t n = __builtin_ctz(x | 0x80000000u);
+    return (n + 1) & -(uint32_t)(x != 0);
+}
+
+// Same for a 64-bit word: index of first set bit (1-indexed), 0 if none
+__attribute__((noinline))
+uint32_t ffs64_ctz(uint64_t x) {
+    uint32_t n = (uint32_t)__builtin_ctzll(x | 0x8000000000000000ull);
+    return (n + 1) & -(uint32_t)(x != 0);
+}
@@ -0,0 +1,24 @@
+#include "ffs_bitmap.c"
+#include "ffs_variants.h"
+
+// Every ffs source in one translation unit, so that ffs_variants.bc and
+// the native users (ffs_variants_test.c, bench/bench_ffs.c) reach every
+// variant registered in ffs_variants.h. A new variant in a new file is
+// included here.
+
+// A registered name without a matching definition fails here, not in SAW
+#define FFS_VARIANT_DECL(name, what) uint32_t ffs_##name(uint32_t x);
+FFS_VARIANTS(FFS_VARIANT_DECL)
+
+struct ffs_variant {
+    const char *name;           // without the ffs_ prefix
+    const char *what;
+    uint32_t (*fn)(uint32_t);
+};
+
+#define FFS_VARIANT_ENTRY(name, what) { #name, what, ffs_##name },
+static const struct ffs_variant ffs_variants[] = {
+    FFS_VARIANTS(FFS_VARIANT_ENTRY)
+};
+
+#define FFS_NVARIANTS (sizeof ffs_variants / sizeof ffs_variants[0])
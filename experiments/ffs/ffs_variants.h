@@ -0,0 +1,25 @@
+/*
+ * Registry of the ffs implementations proved equal to ffs_ref
+ *
+ * One line per variant: X(name, what) stands for
+ *   uint32_t ffs_<name>(uint32_t x)
+ * defined in ffs_variants.c or a file it includes. Registering a variant
+ * here is all it takes to have it
+ *   - proved equal to ffs_ref (make verify: one SAW stage per variant,
+ *     ffs_variant_<name>.saw, generated from this list and run side by
+ *     side under make -jN)
+ *   - checked natively against ffs_ref (make test-variants)
+ *   - benchmarked against ffs_ref (bench/bench_ffs.c, make bench)
+ *
+ * Each variant is proved against ffs_ref only: equality is transitive,
+ * so N proofs cover every pair, and adding a variant costs one proof.
+ * ffs_bug is deliberately not here (ffs.saw finds its counterexample).
+ *
+ * The Makefile reads the names through the preprocessor, so keep this
+ * file to the macro below.
+ */
+
+#define FFS_VARIANTS(X) \
+    X(imp,  "binary search") \
+    X(musl, "de Bruijn multiply and table lookup") \
+    X(ctz,  "count trailing zeros, branch-free")
@@ -0,0 +1,39 @@
+// Native test of every variant in ffs_variants.h against ffs_ref
+// Run: make test-variants
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ffs_variants.c"
+
+int main(void) {
+    int failures = 0;
+
+    for (size_t v = 0; v < FFS_NVARIANTS; v++) {
+        const struct ffs_variant *var = &ffs_variants[v];
+        int bad = 0;
+
+        // Zero, every single bit and every run of high bits
+        if (var->fn(0) != ffs_ref(0)) bad++;
+        for (int b = 0; b < 32; b++) {
+            if (var->fn(1u << b) != ffs_ref(1u << b)) bad++;
+            if (var->fn(~0u << b) != ffs_ref(~0u << b)) bad++;
+        }
+
+        srand(1);
+        for (int t = 0; t < 1000000; t++) {
+            uint32_t x = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+            x &= (uint32_t)-1 << (rand() % 32);
+            if (var->fn(x) != ffs_ref(x)) bad++;
+        }
+
+        printf("  %-6s ffs_%-6s (%s)\n", bad ? "FAIL" : "ok", var->name, var->what);
+        failures += bad;
+    }
+
+    if (failures) {
+        printf("ffs_variants: %d failures\n", failures);
+        return 1;
+    }
+    printf("ffs_variants: %zu variants match ffs_ref\n", (size_t)FFS_NVARIANTS);
+    return 0;
+}
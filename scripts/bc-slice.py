@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+"""Hash the part of a bitcode module that a SAW script actually depends on.
+
+  bc-slice.py script.saw [included.saw ...]
+      For each module the scripts load (m <- load_bitcode "x.bc"), print
+      one cache-key line (scripts/saw-cache.sh):
+        slice <bc> <sha256> <root> ...
+      hashing only the functions the scripts llvm_verify / llvm_extract /
+      llvm_unsafe_assume_spec in that module, everything they reference
+      transitively (callees, globals and their initializers), the named
+      types and the struct layouts in the debug info. A module gets
+      "<sha256>  <bc>" of the whole file instead if its variable is used
+      any other way (a helper taking it as a parameter, say), if one of
+      those functions is not defined in it, or if llvm-dis ($LLVM_DIS)
+      is not available. Bitcode paths are prefixed with $SAW_BCDIR.
+
+  bc-slice.py --bc x.bc fn [fn ...] [--list] [--used-types]
+      Hash the slice rooted at the given functions, or with --list print
+      the functions and globals in it. --used-types only hashes the named
+      types the slice refers to (and the debug layouts if it refers to
+      any), so the same functions compiled into another module hash the
+      same: the theorem keys of scripts/theorem-store.py.
+
+What is left out: source line and column numbers, metadata and attribute
+group numbering, and the numbering of unnamed string constants. Editing
+one function in a file therefore leaves the key of every proof that
+neither verifies nor calls it unchanged.
+"""
+
+import argparse
+import hashlib
+import os
+import re
+import subprocess
+import sys
+
+NAME = r'(?:[-a-zA-Z$._][-a-zA-Z$._0-9]*|"[^"]*"|\d+)'
+REF = re.compile(r"@(" + NAME + r")")
+DEFINE = re.compile(r"^define\b[^@]*@(" + NAME + r")\(")
+DECLARE = re.compile(r"^declare\b[^@]*@(" + NAME + r")\(")
+GLOBAL = re.compile(r"^@(" + NAME + r")\s*=")
+UNNAMED = re.compile(r"^\.[A-Za-z_]+(\.\d+)?$")     # .str, .str.3, ...
+TYPEREF = re.compile(r"%(" + NAME + r")")
+ROOTS = re.compile(r'\b(?:llvm_verify|llvm_unsafe_assume_spec|llvm_extract|llvm_refine_spec'
+                   r'|crucible_llvm_verify|crucible_llvm_unsafe_assume_spec|crucible_llvm_extract)'
+                   r'\s+(\w+)\s+"([^"]+)"')
+GLOBAL_ROOTS = re.compile(r'\b(?:llvm_global|llvm_global_initializer|llvm_alloc_global'
+                          r'|crucible_global|crucible_global_initializer|crucible_alloc_global)'
+                          r'\s+"([^"]+)"')
+# export_verified / import_verified / export_theorem / import_theorem
+# m "x.bc" "fn" ... (scripts/prelude.saw)
+STORE_ROOTS = re.compile(r'\b(?:export_verified|import_verified|export_theorem|import_theorem)\s+(\w+)\s+"[^"]*"\s+"([^"]+)"')
+LOADS = re.compile(r'\b(\w+)\s*<-\s*(?:load_bitcode|llvm_load_module)\s+"([^"]+)"')
+
+
+def disassemble(bc):
+    llvm_dis = os.environ.get("LLVM_DIS", "llvm-dis")
+    try:
+        return subprocess.run([llvm_dis, bc, "-o", "-"], check=True,
+                              capture_output=True, text=True).stdout
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+
+def parse(ll):
+    """Entities of a module: {name: text}, plus types and debug layouts."""
+    ents, types, layouts = {}, [], []
+    lines = ll.splitlines()
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        m = DEFINE.match(line)
+        if m:
+            body = [line]
+            while not lines[i].startswith("}") and i + 1 < len(lines):
+                i += 1
+                body.append(lines[i])
+            ents[m.group(1)] = "\n".join(body)
+        elif DECLARE.match(line):
+            ents.setdefault(DECLARE.match(line).group(1), line)
+        elif GLOBAL.match(line):
+            ents[GLOBAL.match(line).group(1)] = line
+        elif re.match(r"^%\S+\s*=\s*type\b", line):
+            types.append(line)
+        elif re.match(r"^!\d+\s*=.*\b(DICompositeType|DIDerivedType)\(", line):
+            layouts.append(normalize(line))
+        i += 1
+    return ents, types, layouts
+
+
+def normalize(text):
+    text = re.sub(r"\b(line|column|scopeLine):\s*\d+", r"\1: 0", text)
+    text = re.sub(r"!\d+", "!N", text)
+    return re.sub(r"#\d+", "#N", text)
+
+
+def closure(ents, roots):
+    seen, todo, missing = [], list(roots), []
+    while todo:
+        n = todo.pop(0)
+        if n in seen or n in missing:
+            continue
+        if n not in ents:
+            missing.append(n)
+            continue
+        seen.append(n)
+        todo += REF.findall(ents[n])
+    return seen, missing
+
+
+def used_types(ents, names, types, layouts):
+    """The type definitions the named entities refer to, and the layouts
+    if any of those is named"""
+    defs = {TYPEREF.match(t).group(1): t for t in types}
+    seen, todo = [], [r for n in names for r in TYPEREF.findall(ents[n])]
+    while todo:
+        t = todo.pop(0)
+        if t in defs and t not in seen:
+            seen.append(t)
+            todo += TYPEREF.findall(defs[t].split("=", 1)[1])
+    return [defs[t] for t in seen], (layouts if seen else [])
+
+
+def slice_hash(ll, roots, global_roots=(), only_used_types=False):
+    ents, types, layouts = parse(ll)
+    roots = list(roots) + [g for g in global_roots if g in ents]
+    names, missing = closure(ents, roots)
+    if only_used_types:
+        types, layouts = used_types(ents, names, types, layouts)
+    # Unnamed constants are renamed after their contents, so a string added
+    # in an unrelated function does not renumber the ones used here
+    canon = {n: ".anon." + hashlib.sha256(ents[n].split("=", 1)[1].encode()).hexdigest()[:12]
+             for n in names if UNNAMED.match(n)}
+    rename = lambda t: REF.sub(lambda m: "@" + canon.get(m.group(1), m.group(1)), t)
+    h = hashlib.sha256()
+    for n in sorted(names, key=lambda n: canon.get(n, n)):
+        h.update(normalize(rename(ents[n])).encode() + b"\n")
+    for n in missing:
+        h.update(f"MISSING {n}\n".encode())
+    for t in sorted(types) + sorted(layouts):
+        h.update(t.encode() + b"\n")
+    return h.hexdigest(), names, missing
+
+
+def file_hash(path):
+    with open(path, "rb") as f:
+        return hashlib.sha256(f.read()).hexdigest()
+
+
+def strip_saw(text):
+    text = re.sub(r"//[^\n]*", "", text)
+    text = re.sub(r"\{\{.*?\}\}", "", text, flags=re.S)
+    return text
+
+
+def script_keys(sources):
+    texts = {s: strip_saw(open(s).read()) for s in sources if os.path.isfile(s)}
+    loads, roots, uses = {}, {}, {}
+    global_roots = set()
+    for src, text in texts.items():
+        for var, bc in LOADS.findall(text):
+            loads.setdefault(bc, set()).add(var)
+        for var, fn in ROOTS.findall(text) + STORE_ROOTS.findall(text):
+            roots.setdefault(var, set()).add(fn)
+        global_roots.update(GLOBAL_ROOTS.findall(text))
+    # A module variable must only appear where it is loaded and as the
+    # module argument of a recognised call; prelude.saw only wraps those
+    for src, text in texts.items():
+        if os.path.basename(src) == "prelude.saw":
+            continue
+        text = re.sub(r'"[^"]*"', '""', LOADS.sub("", STORE_ROOTS.sub("", ROOTS.sub("", text))))
+        for var in {v for vs in loads.values() for v in vs}:
+            uses[var] = uses.get(var, 0) + len(re.findall(r"\b%s\b" % re.escape(var), text))
+    bcdir = os.environ.get("SAW_BCDIR", "")
+    for bc in sorted(loads):
+        path = bcdir + bc
+        if not os.path.isfile(path):
+            print(f"MISSING  {path}")
+            continue
+        fns = set().union(*(roots.get(v, set()) for v in loads[bc]))
+        ll = None
+        if fns and not any(uses.get(v) for v in loads[bc]):
+            ll = disassemble(path)
+        if ll is not None:
+            digest, _, missing = slice_hash(ll, sorted(fns), sorted(global_roots))
+            # A root that is not defined (inlined away at -O2, or a broken
+            # disassembly) leaves nothing to hash for it
+            if not missing:
+                print(f"slice {path} {digest} {' '.join(sorted(fns))}")
+                continue
+        print(f"{file_hash(path)}  {path}")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("args", nargs="+", help="SAW sources, or with --bc the root functions")
+    ap.add_argument("--bc", help="bitcode module to slice")
+    ap.add_argument("--list", action="store_true", help="with --bc: print the slice")
+    ap.add_argument("--used-types", action="store_true",
+                    help="with --bc: hash only the types the slice refers to")
+    a = ap.parse_args()
+    if not a.bc:
+        script_keys(a.args)
+        return 0
+    ll = disassemble(a.bc)
+    if ll is None:
+        print(f"{a.bc}: cannot disassemble (LLVM_DIS={os.environ.get('LLVM_DIS', 'llvm-dis')})",
+              file=sys.stderr)
+        return 1
+    digest, names, missing = slice_hash(ll, a.args, only_used_types=a.used_types)
+    if a.list:
+        for n in names:
+            print(n)
+        for n in missing:
+            print(f"{n} (not in module)")
+    else:
+        print(digest)
+    return 1 if missing and not names else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
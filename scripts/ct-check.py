@@ -0,0 +1,701 @@
+#!/usr/bin/env python3
+"""Constant-time check of the benchmarked kernels on their LLVM bitcode.
+
+  ct-check.py KERNELS [--dir DIR] [--jsonl OUT] [--baseline BASE] [-v]
+      For every line of the manifest KERNELS (bench/ct_kernels.txt),
+      disassemble DIR/<module>.bc ($LLVM_DIS) and report each place where
+      the function, or anything it calls, lets a secret pick
+      - a branch: br / switch / indirectbr on a secret condition,
+      - an address: load, store or prefetch through a pointer computed
+        from a secret (a table lookup indexed by key or data bytes),
+      - a division: udiv / sdiv / urem / srem of a secret (variable
+        latency on most cores),
+      - a call: secret data passed to a function whose body is not in
+        the module, or a call through a secret function pointer.
+      A kernel with no such site is constant-time. OUT gets one JSON line
+      per kernel, keyed by (kernel, variant) like bench/results.jsonl.
+      With --baseline, exit 1 if a kernel that was constant-time in BASE
+      no longer is, or now has more sites. If BASE does not exist yet,
+      this run is written to it and nothing is compared.
+
+Manifest lines are
+  kernel variant module function args [globals]
+where args has one comma-separated item per parameter:
+  -        public (for a pointer: the memory it points to is public)
+  s        the value is secret
+  *s       points to secret memory; *s:A-B[+C-D] only bytes [A, B)
+  **s      points to an array of pointers to secret memory
+and globals (optional) lists the secret globals, e.g. @K,@K89.
+
+The analysis is a flow-insensitive taint propagation over SSA values and
+memory regions (one per argument, alloca and global; byte ranges where
+the offset is constant, or bounded by the array a variable index
+selects from, as in ctx->data[ctx->datalen]). Calls into defined functions are followed with
+the taint of their arguments. Implicit flows are not tracked: a secret
+branch is already reported. select is treated as data flow, since the
+backends lower it to conditional moves; a backend that turns it into a
+branch is not seen here. Warnings about sites are only as precise as
+the bitcode: at -O2 inlined helpers report their own source lines when
+the module has debug info (-g).
+"""
+
+import argparse
+import importlib.util
+import json
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+NAME = r'(?:[-a-zA-Z$._][-a-zA-Z$._0-9]*|"[^"]*"|\d+)'
+LOCAL = re.compile(r"%(" + NAME + r")")
+GLOBALREF = re.compile(r"@(" + NAME + r")")
+DEFINE = re.compile(r"^define\b[^@]*@(" + NAME + r")\(")
+TYPEDEF = re.compile(r"^%(" + NAME + r")\s*=\s*type\s+(.*)$")
+GLOBAL = re.compile(r"^@(" + NAME + r")\s*=")
+META = re.compile(r"^!(\d+)\s*=\s*(?:distinct\s+)?(.*)$")
+ATTACH = re.compile(r",\s*!\w[\w.]*\s+(?:!\d+|!\{[^}]*\})")
+DBG = re.compile(r"!dbg !(\d+)")
+CALLEE = re.compile(r"([@%])(" + NAME + r")\(")
+RESULT = re.compile(r"^%(" + NAME + r")\s*=\s*(.*)$")
+LABEL = re.compile(r"^(?:" + NAME + r"):")
+CONSTGEP = re.compile(r"\bgetelementptr\b[^(]*\(")
+
+# Intrinsics that neither compute nor touch memory
+IGNORE = ("llvm.dbg.", "llvm.lifetime.", "llvm.assume", "llvm.experimental.noalias",
+          "llvm.invariant.", "llvm.var.annotation", "llvm.stacksave", "llvm.stackrestore",
+          "llvm.donothing", "llvm.pseudoprobe")
+# Intrinsics that load or store through their pointer operands
+MEMORY = ("llvm.prefetch", "llvm.masked.")
+DIVISION = ("udiv", "sdiv", "urem", "srem")
+
+
+def bc_slice():
+    spec = importlib.util.spec_from_file_location("bc_slice", os.path.join(HERE, "bc-slice.py"))
+    mod = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(mod)
+    return mod
+
+
+def split_top(s, sep=","):
+    """Split s at sep outside (), [], {} and <>."""
+    parts, depth, cur, quote = [], 0, [], False
+    for ch in s:
+        if ch == '"':
+            quote = not quote
+        elif not quote:
+            if ch in "([{<":
+                depth += 1
+            elif ch in ")]}>":
+                depth -= 1
+            elif ch == sep and depth == 0:
+                parts.append("".join(cur).strip())
+                cur = []
+                continue
+        cur.append(ch)
+    if "".join(cur).strip():
+        parts.append("".join(cur).strip())
+    return parts
+
+
+def matching(s, i):
+    """Index of the bracket closing the one at s[i]."""
+    depth = 0
+    for j in range(i, len(s)):
+        if s[j] in "([{<":
+            depth += 1
+        elif s[j] in ")]}>":
+            depth -= 1
+            if depth == 0:
+                return j
+    return len(s) - 1
+
+
+def leading_type(s):
+    """Split "<type> <rest>" into (type, rest)."""
+    s = s.strip()
+    if s.startswith("<{"):
+        end = matching(s, 1) + 2
+    elif s[:1] in "[{<":
+        end = matching(s, 0) + 1
+    else:
+        m = re.match(r"%" + NAME + r"|[a-z_0-9]+", s)
+        end = m.end() if m else 0
+    while True:
+        m = re.match(r"\s*(\*|addrspace\(\d+\)\s*\*?)", s[end:])
+        if not m:
+            break
+        end += m.end()
+    return s[:end].strip(), s[end:].strip()
+
+
+class Module:
+    def __init__(self, ll):
+        self.types, self.globals, self.funcs, self.meta = {}, set(), {}, {}
+        lines = ll.splitlines()
+        i = 0
+        while i < len(lines):
+            line = lines[i]
+            m = DEFINE.match(line)
+            if m:
+                body = []
+                while i + 1 < len(lines) and not lines[i + 1].startswith("}"):
+                    i += 1
+                    body.append(lines[i])
+                self.funcs[m.group(1)] = Function(m.group(1), line, body)
+            elif TYPEDEF.match(line):
+                t = TYPEDEF.match(line)
+                self.types[t.group(1)] = t.group(2).strip()
+            elif GLOBAL.match(line):
+                self.globals.add(GLOBAL.match(line).group(1))
+            elif META.match(line):
+                t = META.match(line)
+                self.meta[t.group(1)] = t.group(2)
+            i += 1
+        self._sizes = {}
+
+    def layout(self, t):
+        """(size, align) in bytes of an LLVM type, x86-64 / AArch64 ABI."""
+        t = t.strip()
+        if t in self._sizes:
+            return self._sizes[t]
+        r = (8, 8)
+        m = re.fullmatch(r"i(\d+)", t)
+        if m:
+            n = (int(m.group(1)) + 7) // 8
+            a = 1
+            while a < n and a < 16:
+                a *= 2
+            r = ((n + a - 1) // a * a, min(a, 16))
+        elif t in ("half", "bfloat"):
+            r = (2, 2)
+        elif t == "float":
+            r = (4, 4)
+        elif t == "double":
+            r = (8, 8)
+        elif t in ("x86_fp80", "fp128"):
+            r = (16, 16)
+        elif t == "ptr" or t.endswith("*"):
+            r = (8, 8)
+        elif t.startswith("["):
+            n, _, elem = t[1:-1].partition(" x ")
+            es, ea = self.layout(elem)
+            r = (int(n) * es, ea)
+        elif t.startswith("<{"):
+            r = (sum(self.layout(f)[0] for f in split_top(t[2:-2])), 1)
+        elif t.startswith("<"):
+            n, _, elem = t[1:-1].partition(" x ")
+            r = (int(n) * self.layout(elem)[0],) * 2
+        elif t.startswith("{"):
+            off, align = 0, 1
+            for f in split_top(t[1:-1]):
+                fs, fa = self.layout(f)
+                off = (off + fa - 1) // fa * fa + fs
+                align = max(align, fa)
+            r = ((off + align - 1) // align * align, align)
+        elif t.startswith("%") and t[1:] in self.types:
+            self._sizes[t] = (8, 8)     # opaque or recursive: a guess
+            r = self.layout(self.types[t[1:]])
+        self._sizes[t] = r
+        return r
+
+    def size(self, t):
+        return self.layout(t)[0]
+
+    def field_offset(self, t, k):
+        """Byte offset of field k of struct type t."""
+        t = t.strip()
+        if t.startswith("%") and t[1:] in self.types:
+            t = self.types[t[1:]]
+        packed = t.startswith("<{")
+        fields = split_top(t[2:-2] if packed else t[1:-1])
+        off = 0
+        for f in fields[:k]:
+            fs, fa = self.layout(f)
+            if not packed:
+                off = (off + fa - 1) // fa * fa
+            off += fs
+        if not packed and k < len(fields):
+            fa = self.layout(fields[k])[1]
+            off = (off + fa - 1) // fa * fa
+        return off, (fields[k] if k < len(fields) else "i8")
+
+    def location(self, dbg):
+        """file:line of a !DILocation, or None."""
+        loc = self.meta.get(dbg, "")
+        m = re.search(r"line: (\d+)", loc)
+        if not loc.startswith("!DILocation") or not m:
+            return None
+        scope = re.search(r"scope: !(\d+)", loc)
+        seen = set()
+        while scope and scope.group(1) not in seen:
+            seen.add(scope.group(1))
+            text = self.meta.get(scope.group(1), "")
+            f = re.search(r"file: !(\d+)", text)
+            if f:
+                name = re.search(r'filename: "([^"]*)"', self.meta.get(f.group(1), ""))
+                if name:
+                    return f"{os.path.basename(name.group(1))}:{m.group(1)}"
+            scope = re.search(r"scope: !(\d+)", text)
+        return f"line {m.group(1)}"
+
+
+class Function:
+    def __init__(self, name, header, body):
+        self.name = name
+        start = header.index("@" + name) + len(name) + 1
+        close = matching(header, header.index("(", start))
+        self.params, n = [], 0
+        for p in split_top(header[header.index("(", start) + 1:close]):
+            if p == "...":
+                continue
+            m = re.search(r"%(" + NAME + r")\s*$", p)
+            if m:
+                self.params.append(m.group(1))
+            else:
+                self.params.append(str(n))
+                n += 1
+        self.insts = []
+        pending = ""
+        for line in body:
+            line = line.split(";", 1)[0].rstrip() if '"' not in line else line.rstrip()
+            if not line.strip() or LABEL.match(line.strip()):
+                continue
+            pending = (pending + " " + line.strip()) if pending else line.strip()
+            if pending.count("[") > pending.count("]"):
+                continue                        # multi-line switch
+            self.insts.append(Inst(pending))
+            pending = ""
+
+
+class Inst:
+    def __init__(self, text):
+        m = DBG.search(text)
+        self.dbg = m.group(1) if m else None
+        text = ATTACH.sub("", text)
+        m = RESULT.match(text)
+        self.result = m.group(1) if m else None
+        body = m.group(2) if m else text
+        words = body.split(None, 1)
+        op = words[0] if words else ""
+        rest = words[1] if len(words) > 1 else ""
+        if op in ("tail", "musttail", "notail"):
+            op, _, rest = rest.partition(" ")
+        self.op, self.rest, self.text = op, rest, text.strip()
+
+
+BOTTOM = (False, ())
+EXACT = (0, 0)
+
+
+# A points-to entry is (region, off): off is None (anywhere in the region)
+# or (lo, hi), the pointer is region + k for some lo <= k <= hi
+
+def shift(off, k):
+    return None if off is None else (off[0] + k, off[1] + k)
+
+
+def merge(a, b):
+    """The offset covering a and b; None unless one already covers the other
+    (so a pointer stepped through a loop does not widen forever)."""
+    if a is None or b is None:
+        return None
+    if a[0] <= b[0] and b[1] <= a[1]:
+        return a
+    if b[0] <= a[0] and a[1] <= b[1]:
+        return b
+    return None
+
+
+def join(*vals):
+    taint, pts = False, {}
+    for t, p in vals:
+        taint = taint or t
+        for r, off in p:
+            pts[r] = merge(pts[r], off) if r in pts else off
+    return taint, tuple(sorted(pts.items(), key=lambda x: (x[0], x[1] is None, x[1] or EXACT)))
+
+
+class Region:
+    def __init__(self):
+        self.all = False
+        self.ranges = []            # secret [lo, hi) byte ranges
+        self.ptrs = BOTTOM          # what the pointers stored in it point to
+
+    def secret(self, off, size):
+        if self.all:
+            return True
+        if off is None or size is None:
+            return bool(self.ranges)
+        return any(lo < off[1] + size and off[0] < hi for lo, hi in self.ranges)
+
+    def any_secret(self):
+        return self.all or bool(self.ranges)
+
+    def mark(self, off, size):
+        if self.all or (off is not None and size is not None and
+                        any(lo <= off[0] and off[1] + size <= hi for lo, hi in self.ranges)):
+            return False
+        if off is None or size is None:
+            self.all = True
+        else:
+            self.ranges.append((off[0], off[1] + size))
+        return True
+
+
+class Analysis:
+    def __init__(self, mod):
+        self.mod = mod
+        self.regions = {}
+        self.memo = {}              # (fn, args) -> (epoch, return value)
+        self.stack = set()
+        self.sites = {}             # (kind, where) -> detail
+        self.changed = False
+        self.epoch = 0
+
+    def region(self, name):
+        if name not in self.regions:
+            self.regions[name] = Region()
+        return self.regions[name]
+
+    def site(self, kind, fn, inst, what):
+        loc = self.mod.location(inst.dbg) if inst.dbg else None
+        where = f"{fn} {loc or inst.text[:60]}"
+        self.sites.setdefault((kind, where), what)
+
+    # -- values -------------------------------------------------------------
+
+    def operand(self, env, text):
+        """Taint and points-to of every value an operand text refers to."""
+        vals = []
+        text = re.sub(r"\blabel\s+%" + NAME, "", text)
+        m = CONSTGEP.search(text)
+        if m:
+            # A constant-expression GEP (a field of a global): its own offset
+            close = matching(text, m.end() - 1)
+            return join(self.gep(env, text[m.end():close]),
+                        self.operand(env, text[:m.start()] + text[close + 1:]))
+        for name in LOCAL.findall(text):
+            if name in env:
+                vals.append(env[name])
+        for name in GLOBALREF.findall(text):
+            if name in self.mod.globals or name in self.mod.funcs:
+                exact = re.fullmatch(r".*\s@" + re.escape(name) + r"|@" + re.escape(name), text.strip())
+                vals.append((False, ((f"@{name}", EXACT if exact else None),)))
+        return join(*vals) if vals else BOTTOM
+
+    def loaded(self, ptr, ty):
+        size = self.mod.size(ty) if ty else None
+        taint = any(self.region(r).secret(off, size) for r, off in ptr[1])
+        pts = join(*[self.region(r).ptrs for r, _ in ptr[1]])[1] if ptr[1] else ()
+        return taint, pts
+
+    def stored(self, ptr, val, ty):
+        size = self.mod.size(ty) if ty else None
+        for r, off in ptr[1]:
+            reg = self.region(r)
+            if val[0] and reg.mark(off, size):
+                self.changed = True
+            if val[1]:
+                new = join(reg.ptrs, (False, val[1]))
+                if new != reg.ptrs:
+                    reg.ptrs = new
+                    self.changed = True
+
+    def any_secret(self, val):
+        return val[0] or any(self.region(r).any_secret() for r, _ in val[1])
+
+    def gep(self, env, rest):
+        parts = split_top(re.sub(r"^((inbounds|nuw|nusw|inrange(\([^)]*\))?)\s+)+", "", rest))
+        ty, base = parts[0], self.operand(env, parts[1])
+        taint, off, cur = base[0], EXACT, ty
+        for i, idx in enumerate(parts[2:]):
+            idx = re.sub(r"^inrange\s+", "", idx)
+            v = self.operand(env, idx)
+            taint = taint or v[0]
+            if off is None:
+                continue
+            m = re.fullmatch(r"\S+\s+(-?\d+)", idx.strip())
+            if i == 0:
+                off = shift(off, int(m.group(1)) * self.mod.size(cur)) if m else None
+                continue
+            t = cur.strip()
+            full = self.mod.types.get(t[1:], t) if t.startswith("%") else t
+            if full.startswith("{") or full.startswith("<{"):
+                foff, cur = self.mod.field_offset(t, int(m.group(1)) if m else 0)
+                off = shift(off, foff) if m else None
+                continue
+            n, _, elem = full[1:-1].partition(" x ")
+            es = self.mod.size(elem)
+            cur = elem
+            if m:
+                off = shift(off, int(m.group(1)) * es)
+            elif n.strip().isdigit():
+                # A variable index stays inside the array (inbounds)
+                off = (off[0], off[1] + (int(n) - 1) * es)
+            else:
+                off = None
+        pts = tuple((r, None if off is None or o is None else (o[0] + off[0], o[1] + off[1]))
+                    for r, o in base[1])
+        return taint, pts
+
+    # -- instructions -------------------------------------------------------
+
+    def call(self, fn, env, inst):
+        m = CALLEE.search(inst.rest)
+        if not m:
+            return BOTTOM
+        open_at = m.end() - 1
+        args_text = inst.rest[open_at + 1:matching(inst.rest, open_at)]
+        args = [self.operand(env, a) for a in split_top(args_text)]
+        name = m.group(2)
+        if m.group(1) == "%":
+            target = env.get(name, BOTTOM)
+            if target[0]:
+                self.site("call", fn, inst, "call through a secret function pointer")
+            return self.external(fn, inst, "(indirect)", args)
+        if name.startswith(IGNORE):
+            return BOTTOM
+        if name.startswith(("llvm.memcpy", "llvm.memmove", "llvm.memset")):
+            dst = args[0]
+            if dst[0]:
+                self.site("store", fn, inst, f"{name}: secret-dependent destination")
+            if len(args) > 2 and args[2][0]:
+                self.site("branch", fn, inst, f"{name}: secret length")
+            n = re.fullmatch(r"\S+\s+(\d+)", split_top(args_text)[2].strip()) if len(args) > 2 else None
+            size = int(n.group(1)) if n else None
+            if name.startswith("llvm.memset"):
+                src = args[1][0]
+            else:
+                if args[1][0]:
+                    self.site("load", fn, inst, f"{name}: secret-dependent source")
+                src = any(self.region(r).secret(off, size) for r, off in args[1][1])
+                for r, _ in args[1][1]:
+                    self.stored(dst, (False, self.region(r).ptrs[1]), None)
+            if src:
+                for r, off in dst[1]:
+                    if self.region(r).mark(off, size):
+                        self.changed = True
+            return BOTTOM
+        if name.startswith(MEMORY):
+            if any(a[0] and a[1] for a in args):
+                self.site("load", fn, inst, f"{name}: secret-dependent address")
+            return (any(self.any_secret(a) for a in args), ())
+        if name.startswith("llvm."):
+            return join(*args) if args else BOTTOM
+        if name in self.mod.funcs:
+            return self.analyze(name, args)
+        return self.external(fn, inst, name, args)
+
+    def external(self, fn, inst, name, args):
+        secret = any(self.any_secret(a) for a in args)
+        if secret:
+            self.site("call", fn, inst, f"secret data passed to {name}, not in the module")
+            for a in args:
+                for r, _ in a[1]:
+                    if self.region(r).mark(None, None):
+                        self.changed = True
+        return (secret, join(*args)[1] if args else ())
+
+    def step(self, fn, env, inst, ret):
+        op, rest = inst.op, inst.rest
+        if op == "alloca":
+            return (False, ((f"{fn}:%{inst.result}", EXACT),))
+        if op == "load":
+            parts = split_top(re.sub(r"^(volatile|atomic)\s+", "", rest))
+            ptr = self.operand(env, parts[1])
+            if ptr[0]:
+                self.site("load", fn, inst, "secret-dependent load address")
+            return self.loaded(ptr, parts[0])
+        if op == "store":
+            parts = split_top(re.sub(r"^(volatile|atomic)\s+", "", rest))
+            ptr = self.operand(env, parts[1])
+            if ptr[0]:
+                self.site("store", fn, inst, "secret-dependent store address")
+            self.stored(ptr, self.operand(env, parts[0]), leading_type(parts[0])[0])
+            return None
+        if op == "getelementptr":
+            return self.gep(env, rest)
+        if op in ("br", "switch", "indirectbr"):
+            parts = split_top(rest)
+            if (op != "br" or rest.startswith("i1 ")) and self.operand(env, parts[0])[0]:
+                self.site("branch", fn, inst, f"{op} on a secret")
+            return None
+        if op == "ret":
+            if rest and rest != "void":
+                ret.append(self.operand(env, rest))
+            return None
+        if op == "call":
+            return self.call(fn, env, inst)
+        if op == "phi":
+            vals = []
+            for m in re.finditer(r"\[", rest):
+                inner = rest[m.start() + 1:matching(rest, m.start())]
+                vals.append(self.operand(env, split_top(inner)[0]))
+            return join(*vals) if vals else BOTTOM
+        if op in ("cmpxchg", "atomicrmw"):
+            parts = split_top(re.sub(r"^volatile\s+", "", rest))
+            ptr = self.operand(env, parts[0])
+            if ptr[0]:
+                self.site("store", fn, inst, f"secret-dependent {op} address")
+            return self.loaded(ptr, None)
+        val = self.operand(env, rest)
+        if op in DIVISION and val[0]:
+            self.site("div", fn, inst, f"{op} of a secret")
+        return val
+
+    def analyze(self, name, args):
+        key = (name, tuple(args))
+        if key in self.memo and (self.memo[key][0] == self.epoch or key in self.stack):
+            return self.memo[key][1]
+        if key in self.stack:
+            return BOTTOM
+        self.stack.add(key)
+        f = self.mod.funcs[name]
+        env = {p: a for p, a in zip(f.params, args)}
+        for _ in range(64):
+            ret, local = [], False
+            for inst in f.insts:
+                v = self.step(name, env, inst, ret)
+                if v is not None and inst.result is not None:
+                    old = env.get(inst.result)
+                    new = v if old is None else join(old, v)
+                    if new != old:
+                        env[inst.result] = new
+                        local = True
+            if not local:
+                break
+        self.stack.discard(key)
+        result = join(*ret) if ret else BOTTOM
+        if key not in self.memo or self.memo[key][1] != result:
+            self.changed = True
+        self.memo[key] = (self.epoch, result)
+        return result
+
+    def run(self, name, specs, secret_globals):
+        args = []
+        for i, spec in enumerate(specs):
+            reg = f"arg{i}"
+            if spec == "s":
+                args.append((True, ((reg, EXACT),)))
+            elif spec.startswith("**s"):
+                self.region(reg).ptrs = (False, ((f"arg{i}.*", EXACT),))
+                self.region(f"arg{i}.*").all = True
+                args.append((False, ((reg, EXACT),)))
+            elif spec.startswith("*s"):
+                if ":" in spec:
+                    for rng in spec.split(":", 1)[1].split("+"):
+                        lo, _, hi = rng.partition("-")
+                        self.region(reg).ranges.append((int(lo, 0), int(hi, 0)))
+                else:
+                    self.region(reg).all = True
+                args.append((False, ((reg, EXACT),)))
+            else:
+                args.append((False, ((reg, EXACT),)))
+        for g in secret_globals:
+            self.region(g).all = True
+        for self.epoch in range(1, 64):
+            self.changed = False
+            self.analyze(name, args)
+            if not self.changed:
+                break
+        return self.sites
+
+
+def load_manifest(path):
+    entries = []
+    with open(path) as f:
+        for n, line in enumerate(f, 1):
+            words = line.split("#", 1)[0].split()
+            if not words:
+                continue
+            if len(words) not in (5, 6):
+                sys.exit(f"{path}:{n}: expected kernel variant module function args [globals]")
+            kernel, variant, module, fn, args = words[:5]
+            specs = [] if args == "void" else args.split(",")
+            for s in specs:
+                if not re.fullmatch(r"-|s|\*\*s|\*s(:\d+-\d+(\+\d+-\d+)*)?", s):
+                    sys.exit(f"{path}:{n}: bad argument spec {s!r}")
+            globs = words[5].split(",") if len(words) == 6 else []
+            entries.append((kernel, variant, module, fn, specs, globs))
+    return entries
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("kernels")
+    ap.add_argument("--dir", default=".", help="directory holding <module>.bc")
+    ap.add_argument("--jsonl", help="write one JSON line per kernel here")
+    ap.add_argument("--baseline", help="fail on kernels that leak more than here")
+    ap.add_argument("-v", "--verbose", action="store_true", help="list every site")
+    args = ap.parse_args()
+
+    bcs = bc_slice()
+    modules, rows = {}, []
+    for kernel, variant, module, fn, specs, globs in load_manifest(args.kernels):
+        if module not in modules:
+            path = os.path.join(args.dir, module + ".bc")
+            ll = bcs.disassemble(path) if os.path.isfile(path) else None
+            if ll is None:
+                sys.exit(f"ct-check: cannot disassemble {path} (LLVM_DIS={os.environ.get('LLVM_DIS', 'llvm-dis')})")
+            modules[module] = Module(ll)
+        mod = modules[module]
+        if fn not in mod.funcs:
+            # Target-specific variants (AES-NI, SHA-NI) are not built everywhere
+            print(f"{kernel:<15} {variant:<11} {'-':>5}  ({fn} not in {module}.bc)")
+            continue
+        sites = Analysis(mod).run(fn, specs, ["@" + g.lstrip("@") for g in globs])
+        kinds = {}
+        for kind, _ in sites:
+            kinds[kind] = kinds.get(kind, 0) + 1
+        row = {"kernel": kernel, "variant": variant, "module": module, "function": fn,
+               "constant_time": not sites, "sites": len(sites), "kinds": kinds,
+               "where": sorted(f"{k} {w}: {d}" for (k, w), d in sites.items())}
+        rows.append(row)
+        summary = ", ".join(f"{n} {k}" for k, n in sorted(kinds.items())) or "constant-time"
+        print(f"{kernel:<15} {variant:<11} {len(sites):5d}  {summary}")
+        for line in row["where"][:None if args.verbose else 3]:
+            print(f"    {line}")
+        if not args.verbose and len(sites) > 3:
+            print(f"    ... {len(sites) - 3} more (-v)")
+
+    if args.jsonl:
+        with open(args.jsonl, "w") as f:
+            for row in rows:
+                f.write(json.dumps(row, sort_keys=True) + "\n")
+
+    if args.baseline and not os.path.isfile(args.baseline):
+        with open(args.baseline, "w") as f:
+            for row in rows:
+                f.write(json.dumps(row, sort_keys=True) + "\n")
+        print(f"\nct-check: no baseline {args.baseline}; wrote this run as the baseline")
+        return 0
+
+    if args.baseline:
+        base = {}
+        with open(args.baseline) as f:
+            for line in f:
+                if line.strip():
+                    r = json.loads(line)
+                    base[(r["kernel"], r["variant"])] = r
+        regressions = []
+        for row in rows:
+            b = base.get((row["kernel"], row["variant"]))
+            if b is None:
+                continue
+            if b["constant_time"] and not row["constant_time"]:
+                regressions.append(f"{row['kernel']}/{row['variant']}: was constant-time, "
+                                   f"now {row['sites']} secret-dependent sites")
+            elif row["sites"] > b["sites"]:
+                regressions.append(f"{row['kernel']}/{row['variant']}: {b['sites']} -> "
+                                   f"{row['sites']} secret-dependent sites")
+        if regressions:
+            print("")
+            for r in regressions:
+                print(f"CT REGRESSION: {r}")
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
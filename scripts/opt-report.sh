@@ -0,0 +1,151 @@
+#!/bin/bash
+# Pre-flight check of optimised bitcode against what the SAW scripts expect
+#
+# Usage: scripts/opt-report.sh BCDIR script.saw...
+#   (run from the experiment directory; BCDIR is e.g. bc-O2/, see config.mk)
+#
+# Optimisation can break a proof before SAW gets to the solver:
+#   MISSING  a function the script verifies, assumes, extracts or moves
+#            through the theorem store (export_verified ...) is no
+#            longer defined (static and fully inlined, or dead), or an
+#            llvm_struct type is gone because SROA split every use of it
+#            (e.g. struct.SHA1_STATE). SAW will fail to find it.
+#   INLINED  the function is still defined but every call to it was
+#            inlined, while the -O0 bitcode next to the sources still has
+#            call sites. Overrides for it no longer fire: callers are
+#            symbolically executed through its body, so the proof is no
+#            longer compositional (and may blow up or time out).
+# Everything else is listed as OK with its call-site count at both levels.
+# Scripts are read together with the files they include (stage scripts get
+# their load_bitcode and specs from a shared *_specs.saw).
+#
+# Exit status is 1 if anything is MISSING, 0 otherwise.
+
+set -u
+
+LLVM_DIS=${LLVM_DIS:-llvm-dis}
+BCDIR=${1:-}
+shift || true
+
+if [ $# -eq 0 ]; then
+    echo "Usage: $0 BCDIR script.saw..." >&2
+    exit 2
+fi
+
+missing=0
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+# Disassemble a module once; prints the .ll path or nothing if absent
+ll_of() {
+    local bc=$1 out
+    out="$tmp/$(echo "$bc" | tr '/' '_').ll"
+    if [ ! -f "$bc" ]; then
+        return
+    fi
+    if [ ! -f "$out" ]; then
+        "$LLVM_DIS" "$bc" -o "$out" || return
+    fi
+    echo "$out"
+}
+
+# Number of call sites of @name in the given .ll files
+calls() {
+    local name=$1 n=0 c f
+    shift
+    for f in "$@"; do
+        c=$(grep -cE "(call|invoke) .*@\"?${name}\"?\(" "$f")
+        n=$((n + c))
+    done
+    echo "$n"
+}
+
+defined() {
+    local name=$1 f
+    shift
+    for f in "$@"; do
+        grep -qE "^define .*@\"?${name}\"?\(" "$f" && return 0
+    done
+    return 1
+}
+
+for script in "$@"; do
+    # The script with its includes spliced in and // comments dropped
+    saw="$tmp/script.saw"
+    for f in $("$(dirname "$0")/saw-includes.sh" "$script"); do
+        [ -f "$f" ] && sed 's|//.*||' "$f"
+    done > "$saw"
+    modules=$(grep -oE 'load_bitcode "[^"]+"' "$saw" | sed 's/.*"\([^"]*\)"/\1/' | sort -u)
+    if [ -z "$modules" ]; then
+        continue
+    fi
+
+    opt_ll=()
+    o0_ll=()
+    for bc in $modules; do
+        f=$(ll_of "${BCDIR}${bc}")
+        if [ -z "$f" ]; then
+            echo "=== $script: ${BCDIR}${bc} not built, skipped ==="
+            continue 2
+        fi
+        opt_ll+=("$f")
+        f=$(ll_of "$bc")
+        [ -n "$f" ] && o0_ll+=("$f")
+    done
+
+    echo "=== $script (${BCDIR:-./}: $(echo $modules)) ==="
+
+    # The function is the first string argument, or for the theorem store
+    # forms the one after the bitcode file (STORE_ROOTS in bc-slice.py)
+    funcs=$({ grep -oE '(llvm_verify|llvm_unsafe_assume_spec|llvm_extract) +[A-Za-z0-9_]+ +"[^"]+"' "$saw"
+              grep -oE '(export_verified|import_verified|export_theorem|import_theorem) +[A-Za-z0-9_]+ +"[^"]*" +"[^"]+"' "$saw"; } \
+            | sed 's/.*"\([^"]*\)"/\1/' | awk '!seen[$0]++')
+    for fn in $funcs; do
+        case "$fn" in
+        *#*)
+            # __breakpoint__name#parent: the breakpoint must still be called in parent
+            bp=${fn%%#*}
+            parent=${fn#*#}
+            if ! defined "$parent" "${opt_ll[@]}"; then
+                printf '  %-8s %-32s parent %s not defined\n' MISSING "$fn" "$parent"
+                missing=1
+            elif [ "$(calls "$bp" "${opt_ll[@]}")" -eq 0 ]; then
+                printf '  %-8s %-32s breakpoint call removed\n' MISSING "$fn"
+                missing=1
+            else
+                printf '  %-8s %s\n' OK "$fn"
+            fi
+            continue
+            ;;
+        esac
+
+        if ! defined "$fn" "${opt_ll[@]}"; then
+            printf '  %-8s %-32s not defined in optimised bitcode\n' MISSING "$fn"
+            missing=1
+            continue
+        fi
+        n=$(calls "$fn" "${opt_ll[@]}")
+        if [ ${#o0_ll[@]} -gt 0 ]; then
+            n0=$(calls "$fn" "${o0_ll[@]}")
+            if [ "$n" -eq 0 ] && [ "$n0" -gt 0 ]; then
+                printf '  %-8s %-32s calls %d (O0: %d): overrides no longer apply\n' INLINED "$fn" "$n" "$n0"
+            else
+                printf '  %-8s %-32s calls %d (O0: %d)\n' OK "$fn" "$n" "$n0"
+            fi
+        else
+            printf '  %-8s %-32s calls %d\n' OK "$fn" "$n"
+        fi
+    done
+
+    structs=$(grep -oE 'llvm_struct "[^"]+"' "$saw" | sed 's/.*"\([^"]*\)"/\1/' | sort -u)
+    for st in $structs; do
+        if grep -qE "^%\"?${st}\"? = type" "${opt_ll[@]}"; then
+            printf '  %-8s %s\n' OK "$st"
+        else
+            printf '  %-8s %-32s type gone (SROA): llvm_struct "%s" will fail\n' MISSING "$st" "$st"
+            missing=1
+        fi
+    done
+done
+
+exit $missing
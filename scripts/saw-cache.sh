@@ -0,0 +1,231 @@
+#!/bin/bash
+# Run a SAW script unless an identical run has already passed
+#
+# Usage: scripts/saw-cache.sh script.saw
+#   (run from the experiment directory; SAW, SAW_BCDIR, SAW_CACHE,
+#   LLVM_DIS and CRYPTOLPATH from the environment, see config.mk)
+#
+# A run is identified by a hash of everything it reads:
+#   - the script and every .saw file it includes (scripts/saw-includes.sh)
+#   - the bitcode each load_bitcode / llvm_load_module names, from
+#     $SAW_BCDIR: only the functions the script verifies, extracts or
+#     assumes and what they reference (scripts/bc-slice.py), so editing an
+#     unrelated function in the same file keeps the key
+#   - every .cry file in the experiment directory and the files imported
+#     by path, and all .cry files under $CRYPTOLPATH (specs/cryptol-specs),
+#     since Cryptol modules import each other by name
+#   - `saw --version` and `z3 --version`
+#   - the portfolio backend ($SAW_SOLVER or the script's solvers.pin
+#     line, see scripts/prelude.saw)
+# After a passing run the log is stored as $SAW_CACHE/<hash>.log; the next
+# run with the same hash prints "CACHED <hash>" and exits 0 without
+# starting SAW. Failures are never cached. The directory can be copied
+# between machines (CI restores it with actions/cache). Slices leave out
+# file paths and line numbers; a whole-file bitcode hash (no llvm-dis, or
+# a module the script uses in ways bc-slice.py cannot follow) includes
+# the -g source directory, so a checkout at a different path misses.
+#
+# SAW_CACHE= (empty) runs SAW unconditionally.
+#
+# Every run (and every cache hit) also leaves its output in
+# $SAW_LOG_DIR/<experiment>/<script>.log for make verify-report. A real
+# run ends with "@@saw-report process <wall ms> <peak RSS KiB>", the
+# largest resident set of SAW or any solver process it started; a hit
+# keeps the stored run's lines and adds "@@saw-report cached".
+#
+# Theorems a passing run exports (export_verified, scripts/prelude.saw)
+# are filed in $SAW_THEOREMS, by a real run or a cache hit alike, so the
+# scripts that import them find them either way.
+#
+# SAW_MEM_LIMIT=<MiB> caps SAW plus its solvers, see run_saw. A run that
+# hits the cap exits with status 3 (other failures with SAW's), so callers can fall
+# back to a compositional proof of the same statement (config.mk).
+
+set -u
+set -o pipefail
+
+SAW=${SAW:-saw}
+SCRIPT=$1
+BCDIR=${SAW_BCDIR:-}
+CACHE=${SAW_CACHE:-}
+# Read by the portfolio tactic in scripts/prelude.saw
+export SAW_SCRIPT=$SCRIPT
+
+LOG=
+if [ -n "${SAW_LOG_DIR:-}" ]; then
+    rel=$(pwd)
+    rel=${rel#${SAW_ROOT:-}/}
+    LOG="$SAW_LOG_DIR/$rel/${SCRIPT%.saw}.log"
+    mkdir -p "$(dirname "$LOG")"
+fi
+
+# SAW with its output on stdout, plus the process report line. With
+# SAW_MEM_LIMIT (MiB) the resident memory of SAW and its solvers together
+# is sampled every half second; over the cap they are killed, the run
+# ends with "@@saw-report memlimit <KiB> <limit KiB> <call>" and a MEMCAP
+# line naming the proof call that was running, and exits with status 3
+run_saw() {
+    python3 - "$SAW" "$SCRIPT" <<'PY'
+import os, resource, signal, subprocess, sys, threading, time
+
+def tree_rss(root):
+    """{pid: rss KiB} of root and its descendants (ps works on Linux and macOS)"""
+    out = subprocess.run(["ps", "-A", "-o", "pid=,ppid=,rss="],
+                         capture_output=True, text=True).stdout
+    procs = {}
+    for line in out.splitlines():
+        f = line.split()
+        if len(f) == 3:
+            procs[int(f[0])] = (int(f[1]), int(f[2]))
+    tree, todo = {}, [root]
+    while todo:
+        pid = todo.pop()
+        if pid in procs and pid not in tree:
+            tree[pid] = procs[pid][1]
+            todo += [c for c, (pp, _) in procs.items() if pp == pid]
+    return tree
+
+limit = int(os.environ.get("SAW_MEM_LIMIT") or 0) * 1024
+start = time.monotonic()
+over, call = 0, "-"
+if not limit:
+    rc = subprocess.call(sys.argv[1:], stderr=subprocess.STDOUT)
+else:
+    p = subprocess.Popen(sys.argv[1:], stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    running = []
+
+    def relay():
+        for line in p.stdout:
+            sys.stdout.buffer.write(line)
+            sys.stdout.flush()
+            words = line.decode(errors="replace").split()
+            if words[:2] == ["@@saw-report", "begin"]:
+                running[:] = [" ".join(words[2:4])]
+            elif words[:2] == ["@@saw-report", "end"]:
+                running[:] = []
+
+    reader = threading.Thread(target=relay, daemon=True)
+    reader.start()
+    try:
+        while True:
+            try:
+                rc = p.wait(timeout=0.5)
+                break
+            except subprocess.TimeoutExpired:
+                pass
+            tree = tree_rss(p.pid)
+            if sum(tree.values()) > limit:
+                over, call = sum(tree.values()), (running or ["-"])[0]
+                for pid in tree:
+                    try:
+                        os.kill(pid, signal.SIGKILL)
+                    except OSError:
+                        pass
+                p.wait()
+                rc = 3
+                break
+    except KeyboardInterrupt:
+        p.wait()
+        sys.exit(130)
+    reader.join(timeout=5)
+ms = int((time.monotonic() - start) * 1000)
+rss = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+if sys.platform == "darwin":
+    rss //= 1024
+if over:
+    print(f"@@saw-report memlimit {over} {limit} {call}")
+    print(f"MEMCAP: {sys.argv[2]}: {over // 1024} MiB > SAW_MEM_LIMIT={limit // 1024} MiB "
+          f"after {ms // 1000}s, in {call}; SAW and its solvers killed")
+print(f"@@saw-report process {ms} {max(rss, over)}", flush=True)
+sys.exit(rc)
+PY
+}
+
+# run_saw, output also to $LOG (and to $1 if given)
+run_logged() {
+    if [ -n "$LOG" ]; then
+        run_saw | tee "$LOG" ${1:+"$1"}
+    elif [ -n "${1:-}" ]; then
+        run_saw | tee "$1"
+    else
+        run_saw
+    fi
+}
+
+# Theorems exported so far by this run, for import_verified further on
+SAW_THEOREMS_PENDING=$(mktemp "${TMPDIR:-/tmp}/saw-theorems.XXXXXX")
+export SAW_THEOREMS_PENDING
+out= tmp=
+trap 'rm -f "$SAW_THEOREMS_PENDING" ${out:+"$out"} ${tmp:+"$tmp"}' EXIT
+
+# File the theorems exported by the passing run whose output is in $1
+record_theorems() {
+    if [ -n "${SAW_THEOREMS:-}" ]; then
+        python3 "$(dirname "$0")/theorem-store.py" record "$1" "$SCRIPT"
+    fi
+}
+
+if [ -z "$CACHE" ]; then
+    out=$(mktemp "${TMPDIR:-/tmp}/saw-cache.XXXXXX")
+    run_logged "$out" || exit $?
+    record_theorems "$out"
+    exit
+fi
+
+if command -v sha256sum > /dev/null; then
+    hash() { sha256sum "$@"; }
+else
+    hash() { shasum -a 256 "$@"; }
+fi
+
+# Print "<sha256>  <name>" for a file, or a MISSING line so that a later
+# appearance of the file changes the key
+file_hash() {
+    if [ -f "$1" ]; then
+        hash "$1"
+    else
+        echo "MISSING  $1"
+    fi
+}
+
+inputs() {
+    local sources f
+    echo "saw-cache v2"
+    sources=$("$(dirname "$0")/saw-includes.sh" "$SCRIPT")
+    for f in $sources; do
+        file_hash "$f"
+    done
+    python3 "$(dirname "$0")/bc-slice.py" $sources
+    for f in $( (ls *.cry 2> /dev/null; cat $sources 2> /dev/null | sed 's|//.*||' \
+               | grep -oE '^ *import +"[^"]+"' | sed 's/.*"\([^"]*\)"/\1/') | sort -u); do
+        file_hash "$f"
+    done
+    if [ -n "${CRYPTOLPATH:-}" ] && [ -d "$CRYPTOLPATH" ]; then
+        echo "CRYPTOLPATH $(find "$CRYPTOLPATH" -name '*.cry' -type f | LC_ALL=C sort \
+                            | while read -r f; do hash "$f" | cut -d' ' -f1; done | hash | cut -d' ' -f1)"
+    fi
+    echo "saw: $("$SAW" --version 2>&1 | head -n 1)"
+    echo "z3: $(z3 --version 2>&1 | head -n 1)"
+    echo "solver: ${SAW_SOLVER:-} $(awk -v k="$SCRIPT" '$1 == k { print $2 }' solvers.pin 2> /dev/null)"
+}
+
+key=$(inputs | hash | cut -d' ' -f1)
+entry="$CACHE/$key.log"
+
+if [ -f "$entry" ]; then
+    echo "CACHED $key ($SCRIPT passed before, log: $entry)"
+    if [ -n "$LOG" ]; then
+        { cat "$entry"; echo "@@saw-report cached"; } > "$LOG"
+    fi
+    record_theorems "$entry"
+    exit
+fi
+
+mkdir -p "$CACHE"
+tmp="$entry.$$"
+if run_logged "$tmp"; then
+    mv "$tmp" "$entry"
+    record_theorems "$entry"
+else
+    exit $?
+fi
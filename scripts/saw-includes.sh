@@ -0,0 +1,28 @@
+#!/bin/bash
+# List a SAW script and every .saw file it includes, transitively
+#
+# Usage: scripts/saw-includes.sh script.saw...
+#   (run from the experiment directory: include paths are relative to
+#   the cwd, as in SAW)
+#
+# One path per line, each file once, a script before the files it
+# includes. Missing files are listed too and left to the caller.
+
+set -u
+
+seen=" "
+
+walk() {
+    local f=$1 inc
+    case "$seen" in *" $f "*) return ;; esac
+    seen="$seen$f "
+    echo "$f"
+    [ -f "$f" ] || return
+    for inc in $(sed 's|//.*||' "$f" | grep -oE '^ *include +"[^"]+"' | sed 's/.*"\([^"]*\)"/\1/'); do
+        walk "$inc"
+    done
+}
+
+for s in "$@"; do
+    walk "$s"
+done
@@ -0,0 +1,108 @@
+#!/bin/bash
+# Race one SAW script across solver backends and keep the first to pass
+#
+# Usage: scripts/saw-portfolio.sh script.saw [solver ...]
+#   (run from the experiment directory, like saw-cache.sh; the solvers
+#   default to $SAW_PORTFOLIO, else "z3 yices cvc5"; abc only passes
+#   scripts whose portfolio calls keep nothing uninterpreted)
+#
+# Each backend runs the whole script as its own SAW process with
+# SAW_SOLVER set, which every `portfolio [...]` tactic in it follows
+# (scripts/prelude.saw). The first process to pass wins and the rest are
+# killed along with their solvers. The winner is written to solvers.pin as
+#   script.saw <solver> <wall ms>
+# and later runs of the script (make verify) use that backend. The
+# winning log becomes the script's .saw-logs/ entry for make verify-report.
+#
+# Only portfolio tactics depend on the backend. Calls that name
+# w4_unint_z3 etc. run the same way in every process.
+
+set -u
+
+SAW=${SAW:-saw}
+SCRIPT=$1
+shift
+SOLVERS=${*:-${SAW_PORTFOLIO:-z3 yices cvc5}}
+HERE=$(cd "$(dirname "$0")" && pwd)
+PIN=solvers.pin
+
+tmp=$(mktemp -d "${TMPDIR:-/tmp}/saw-portfolio.XXXXXX")
+pids=
+cleanup() {
+    for p in $pids; do
+        kill -- -"$p" 2> /dev/null
+    done
+    rm -rf "$tmp"
+}
+trap cleanup EXIT
+trap 'exit 130' INT TERM
+
+# set -m: one process group per backend, so killing it reaches the solver
+set -m
+for s in $SOLVERS; do
+    (
+        SAW=$SAW SAW_SOLVER=$s SAW_CACHE= SAW_LOG_DIR= \
+            "$HERE/saw-cache.sh" "$SCRIPT" > "$tmp/$s.log" 2>&1
+        echo $? > "$tmp/$s.rc.new" && mv "$tmp/$s.rc.new" "$tmp/$s.rc"
+    ) &
+    pids="$pids $!"
+done
+set +m
+
+winner=
+while :; do
+    running=0
+    for s in $SOLVERS; do
+        if [ ! -f "$tmp/$s.rc" ]; then
+            running=$((running + 1))
+        elif [ "$(cat "$tmp/$s.rc")" = 0 ]; then
+            winner=$s
+            break
+        fi
+    done
+    if [ -n "$winner" ] || [ "$running" -eq 0 ]; then
+        break
+    fi
+    sleep 1
+done
+
+for s in $SOLVERS; do
+    if [ "$s" = "$winner" ]; then
+        status=WON
+    elif [ ! -f "$tmp/$s.rc" ]; then
+        status=killed
+    elif [ "$(cat "$tmp/$s.rc")" = 3 ]; then
+        status=MEMCAP
+    else
+        status=FAIL
+    fi
+    ms=$(sed -n 's/.*@@saw-report process \([0-9]*\) .*/\1/p' "$tmp/$s.log" | tail -n 1)
+    printf '  %-6s %-6s %s\n' "$status" "$s" "${ms:+$((ms / 1000))s}"
+done
+
+if [ -z "$winner" ]; then
+    for s in $SOLVERS; do
+        echo "--- $s"
+        tail -n 20 "$tmp/$s.log" | sed 's/^/    | /'
+    done
+    echo "$SCRIPT: no backend passed"
+    exit 1
+fi
+
+ms=$(sed -n 's/.*@@saw-report process \([0-9]*\) .*/\1/p' "$tmp/$winner.log" | tail -n 1)
+{
+    if [ -f "$PIN" ]; then
+        awk -v k="$SCRIPT" '$1 != k' "$PIN"
+    else
+        echo "# Portfolio backend per script (scripts/saw-portfolio.sh): script solver wall-ms"
+    fi
+    echo "$SCRIPT $winner ${ms:-0}"
+} > "$PIN.new" && mv "$PIN.new" "$PIN"
+echo "$SCRIPT: $winner won, pinned in $PIN"
+
+if [ -n "${SAW_LOG_DIR:-}" ]; then
+    rel=$(pwd)
+    rel=${rel#${SAW_ROOT:-}/}
+    mkdir -p "$SAW_LOG_DIR/$rel"
+    cp "$tmp/$winner.log" "$SAW_LOG_DIR/$rel/${SCRIPT%.saw}.log"
+fi
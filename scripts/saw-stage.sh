@@ -0,0 +1,44 @@
+#!/bin/bash
+# Run one SAW proof stage of a make-scheduled verification DAG
+#
+# Usage: scripts/saw-stage.sh STAMP script.saw
+#   (run from the experiment directory, SAW from the environment)
+#
+# Output goes to a log next to the stamp (x.ok -> x.log), not the
+# terminal, so stages running side by side under make -jN do not
+# interleave. STAMP is touched only if
+# SAW succeeds; make treats it as "this stage's specs are proved" and only
+# then starts the stages that import them (import_verified). On failure the
+# tail of the log is printed and the stamp is removed. A stage killed for
+# going over SAW_MEM_LIMIT is reported as MEMCAP with its peak and the
+# proof call it was in, and exits with status 3.
+#
+# SAW runs through scripts/saw-cache.sh, so a stage whose inputs match a
+# stored passing run is reported as CACHED instead of re-proved.
+
+set -u
+
+SAW=${SAW:-saw}
+STAMP=$1
+SCRIPT=$2
+LOG=${STAMP%.ok}.log
+
+mkdir -p "$(dirname "$STAMP")"
+rm -f "$STAMP"
+start=$(date +%s)
+SAW=$SAW "$(dirname "$0")/saw-cache.sh" "$SCRIPT" > "$LOG" 2>&1
+rc=$?
+if [ $rc -eq 0 ]; then
+    touch "$STAMP"
+    status=PASS
+    grep -q '^CACHED ' "$LOG" && status=CACHED
+    printf '  %-6s %-44s %4ds\n' "$status" "$SCRIPT" $(( $(date +%s) - start ))
+elif [ $rc -eq 3 ]; then
+    printf '  %-6s %-44s %4ds  (log: %s)\n' MEMCAP "$SCRIPT" $(( $(date +%s) - start )) "$LOG"
+    grep '^MEMCAP: ' "$LOG" | sed 's/^/    | /'
+    exit 3
+else
+    printf '  %-6s %-44s %4ds  (log: %s)\n' FAIL "$SCRIPT" $(( $(date +%s) - start )) "$LOG"
+    tail -n 40 "$LOG" | sed 's/^/    | /'
+    exit 1
+fi
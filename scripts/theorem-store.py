@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""Proved overrides shared between SAW scripts (the theorem store).
+
+  theorem-store.py export BC FN LIB SPEC
+      Print the key of the theorem "FN in BC satisfies the spec SPEC of
+      the spec library LIB", just proved by export_verified
+      (scripts/prelude.saw), and note it in $SAW_THEOREMS_PENDING
+  theorem-store.py import BC FN LIB SPEC
+      The same key; fail unless $SAW_THEOREMS holds that theorem or this
+      SAW process already exported it (import_verified). With SAW_THEOREMS
+      empty nothing is checked.
+  theorem-store.py record LOG SCRIPT
+      File every theorem a passing run of SCRIPT exported, from the
+      "@@saw-report theorem" lines of its log (scripts/saw-cache.sh)
+  theorem-store.py list
+      One line per stored theorem
+
+A key hashes what the statement depends on:
+  - the slice of FN in $SAW_BCDIR/BC: its body, its callees and the
+    globals they read, and the types they use (bc-slice.py --used-types).
+    The module it sits in does not matter, so a proof made on aes.bc
+    holds for every module that includes the same aes.c.
+  - the contents of LIB and the name SPEC. A spec with parameters is
+    named with its arguments, e.g. aes_key_setup_spec/16/44/128, by the
+    library function that also builds it (export_theorem /
+    import_theorem in scripts/prelude.saw).
+  - the Cryptol the spec can refer to: the .cry files in the experiment
+    directory and under $CRYPTOLPATH.
+If llvm-dis is not available, or FN is not defined in BC, the whole
+bitcode file is hashed instead: the theorem then only holds for BC.
+
+Each theorem is a file $SAW_THEOREMS/<key> naming the function, spec,
+script that proved it and the keys that script imported. It is only
+filed once the whole run has passed; until then scripts that include
+the exporting one (the serial forms of a stage DAG) find it in the
+process's pending list, which scripts/saw-cache.sh creates and removes.
+"""
+
+import hashlib
+import importlib.util
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+MARK = "@@saw-report "
+
+
+def bc_slice():
+    spec = importlib.util.spec_from_file_location("bc_slice", os.path.join(HERE, "bc-slice.py"))
+    mod = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(mod)
+    return mod
+
+
+def file_hash(path):
+    with open(path, "rb") as f:
+        return hashlib.sha256(f.read()).hexdigest()
+
+
+def cryptol_hash():
+    h = hashlib.sha256()
+    dirs = [(".", False)]
+    if os.environ.get("CRYPTOLPATH") and os.path.isdir(os.environ["CRYPTOLPATH"]):
+        dirs.append((os.environ["CRYPTOLPATH"], True))
+    for top, recurse in dirs:
+        files = []
+        for dirpath, dirnames, names in os.walk(top):
+            files += [os.path.join(dirpath, n) for n in names if n.endswith(".cry")]
+            if not recurse:
+                break
+        for f in sorted(files):
+            h.update(file_hash(f).encode() + b"\n")
+    return h.hexdigest()
+
+
+def key(bc, fn, lib, spec):
+    path = os.environ.get("SAW_BCDIR", "") + bc
+    if not os.path.isfile(path):
+        sys.exit(f"theorem-store: {path}: no such bitcode")
+    if not os.path.isfile(lib):
+        sys.exit(f"theorem-store: {lib}: no such spec library")
+    bcs = bc_slice()
+    ll = bcs.disassemble(path)
+    code = None
+    if ll is not None:
+        digest, _, missing = bcs.slice_hash(ll, [fn], only_used_types=True)
+        if not missing:
+            code = f"slice {digest}"
+    if code is None:
+        code = f"file {file_hash(path)} {os.path.abspath(path)}"
+    text = "\n".join(["theorem v1", f"fn {fn}", code,
+                      f"spec {file_hash(lib)} {spec}", f"cryptol {cryptol_hash()}"])
+    return hashlib.sha256(text.encode()).hexdigest()
+
+
+def store():
+    return os.environ.get("SAW_THEOREMS", "")
+
+
+def read_record(path):
+    rec = {}
+    with open(path) as f:
+        for line in f:
+            k, _, v = line.rstrip("\n").partition(" ")
+            rec[k] = v
+    return rec
+
+
+def records():
+    d = store()
+    if not d or not os.path.isdir(d):
+        return []
+    return [(k, read_record(os.path.join(d, k))) for k in sorted(os.listdir(d))
+            if not k.endswith(".tmp")]
+
+
+def pending():
+    path = os.environ.get("SAW_THEOREMS_PENDING", "")
+    if not path or not os.path.isfile(path):
+        return []
+    with open(path) as f:
+        return f.read().split()
+
+
+def cmd_export(bc, fn, lib, spec):
+    k = key(bc, fn, lib, spec)
+    if os.environ.get("SAW_THEOREMS_PENDING"):
+        with open(os.environ["SAW_THEOREMS_PENDING"], "a") as f:
+            f.write(k + "\n")
+    return k
+
+
+def cmd_import(bc, fn, lib, spec):
+    k = key(bc, fn, lib, spec)
+    if not store() or os.path.isfile(os.path.join(store(), k)) or k in pending():
+        return k
+    msg = [f"theorem-store: no proof of {fn} ({lib} {spec}) on {bc} in {store()}"]
+    stale = [r for _, r in records() if r.get("fn") == fn and r.get("spec") == f"{lib} {spec}"]
+    for r in stale:
+        msg.append(f"  stored for other code or specs, proved by {r.get('script')}")
+    msg.append("  run the script that exports it first (see its make target)")
+    sys.exit("\n".join(msg))
+
+
+def cmd_record(log, script):
+    if not store():
+        return
+    exported, imported = [], []
+    with open(log, errors="replace") as f:
+        for line in f:
+            at = line.find(MARK)
+            if at < 0:
+                continue
+            words = line[at + len(MARK):].split()
+            if words[:1] == ["theorem"] and len(words) == 6:
+                exported.append(words[1:])
+            elif words[:1] == ["import"] and len(words) >= 2:
+                imported.append(words[1])
+    os.makedirs(store(), exist_ok=True)
+    rel = os.path.abspath(script)
+    rel = os.path.relpath(rel, os.environ.get("SAW_ROOT") or os.sep)
+    for k, fn, bc, lib, spec in exported:
+        tmp = os.path.join(store(), f"{k}.{os.getpid()}.tmp")
+        with open(tmp, "w") as f:
+            f.write(f"fn {fn}\nbc {os.environ.get('SAW_BCDIR', '')}{bc}\nspec {lib} {spec}\n"
+                    f"script {rel}\nassumes {' '.join(imported) or '-'}\n")
+        os.replace(tmp, os.path.join(store(), k))
+
+
+def cmd_list():
+    for k, r in records():
+        print(f"{k[:12]}  {r.get('fn', '?'):<24} {r.get('spec', '?'):<48} {r.get('script', '?')}")
+
+
+def main():
+    args = sys.argv[1:]
+    if args[:1] == ["export"] and len(args) == 5:
+        sys.stdout.write(cmd_export(*args[1:]))
+    elif args[:1] == ["import"] and len(args) == 5:
+        sys.stdout.write(cmd_import(*args[1:]))
+    elif args[:1] == ["record"] and len(args) == 3:
+        cmd_record(*args[1:])
+    elif args == ["list"]:
+        cmd_list()
+    else:
+        sys.exit(__doc__.strip())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
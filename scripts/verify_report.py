@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+"""Summarise proof timing from SAW run logs and check it against a baseline.
+
+  verify_report.py LOGDIR [--jsonl report.jsonl] [--top 30]
+      Table of every llvm_verify / prove_print call found in the logs
+      under LOGDIR (see scripts/prelude.saw and scripts/saw-cache.sh),
+      slowest first, and one line per script with its wall time and peak
+      memory. --jsonl also writes every record as a JSON line.
+
+  verify_report.py LOGDIR --baseline baseline.jsonl [--tolerance 25]
+      Also compare each call with the baseline and exit 1 if any got
+      slower by more than --tolerance percent (calls under --min-ms in
+      both runs are ignored). With --warn-only the exit status is 0.
+
+Records:
+  {"script", "kind": "llvm_verify"|"prove_print", "name", "index",
+   "solver", "ms", "goals", "goal_size_max", "goal_size_total",
+   "status": "ok"|"fail", "cached"}
+  {"script", "kind": "process", "ms", "peak_rss_kb", "cached",
+   "memcap": null | {"rss_kb", "limit_kb", "call"}}
+
+"name" is the verified function, or for prove_print the last line the
+script printed before it. "index" numbers repeated (script, kind, name)
+calls. "solver" is the solver tactic(s) named where the call is written
+(through one level of let-bound tactics), since a SAW tactic cannot
+report its own name at run time; "portfolio" gets the backend the run
+used appended (portfolio=yices, see scripts/saw-portfolio.sh). Goal
+sizes are SAW's shared (DAG) term sizes from print_goal_size. "memcap"
+is set when the run was killed over SAW_MEM_LIMIT (scripts/saw-cache.sh);
+the call it was in is then the one with status "fail".
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+MARK = "@@saw-report "
+SOLVERS = re.compile(r"\b(portfolio|z3|yices|cvc4|cvc5|boolector|bitwuzla|abc|rme|mathsat"
+                     r"|w4_unint_\w+|w4_abc_\w+|unint_\w+|sbv_\w+|offline_\w+)\b")
+SAW_INFO = re.compile(r"^\[\d\d:\d\d:\d\d")
+SHARED = re.compile(r"shared size:\s*(\d+)", re.I)
+UNSHARED = re.compile(r"unshared size:\s*(\d+)", re.I)
+
+
+def saw_sources(script):
+    """The script and its transitive includes, as {path: text}."""
+    out = {}
+    todo = [script]
+    base = os.path.dirname(script)
+    while todo:
+        f = todo.pop(0)
+        if f in out or not os.path.isfile(f):
+            continue
+        text = re.sub(r"//[^\n]*", "", open(f).read())
+        out[f] = text
+        for inc in re.findall(r'^\s*include\s+"([^"]+)"', text, re.M):
+            todo.append(os.path.normpath(os.path.join(base, inc)))
+    return out
+
+
+def statement(text, start):
+    """Text from start up to the ';' that ends the statement."""
+    depth = 0
+    for i in range(start, len(text)):
+        c = text[i]
+        if c in "([{":
+            depth += 1
+        elif c in ")]}":
+            depth -= 1
+        elif c == ";" and depth <= 0:
+            return text[start:i]
+    return text[start:]
+
+
+class Solvers:
+    """Solver names at llvm_verify / prove_print call sites of one script."""
+
+    def __init__(self, sources):
+        self.sources = sources
+        self.lets = {}
+        for text in sources.values():
+            for m in re.finditer(r"\blet\s+(\w+)", text):
+                self.lets.setdefault(m.group(1), statement(text, m.start()))
+
+    def of(self, stmt, depth=2):
+        found = [m.group(1) for m in SOLVERS.finditer(stmt)]
+        if not found and depth > 0:
+            for ident in re.findall(r"\b[A-Za-z_]\w*\b", stmt):
+                if ident in self.lets:
+                    found += self.of(self.lets[ident], depth - 1)
+        return list(dict.fromkeys(found))
+
+    def llvm_verify(self, fn):
+        found = []
+        for text in self.sources.values():
+            for m in re.finditer(r'\bllvm_verify\s+\w+\s+"%s"' % re.escape(fn), text):
+                found += self.of(statement(text, m.start()))
+        return "+".join(dict.fromkeys(found)) or None
+
+    def prove_print(self, label):
+        # The statement after the print that produced the label; else every
+        # prove_print in the script, if they agree
+        quoted = '"%s"' % label.replace("\\", "\\\\").replace('"', '\\"')
+        for text in self.sources.values():
+            at = text.find(quoted)
+            if at < 0:
+                continue
+            rest = text[at:]
+            rest = rest[rest.find(";") + 1:]
+            pos = 0
+            while pos < len(rest):
+                stmt = statement(rest, pos)
+                pos += len(stmt) + 1
+                if "prove_print" in stmt or any(
+                        "prove_print" in self.lets.get(i, "")
+                        for i in re.findall(r"\b\w+\b", stmt)):
+                    found = self.of(stmt)
+                    if found:
+                        return "+".join(found)
+                    break
+        every = set()
+        for text in self.sources.values():
+            for m in re.finditer(r"\bprove_print\b", text):
+                every.update(self.of(statement(text, m.start())))
+        return every.pop() if len(every) == 1 else None
+
+
+def parse_log(path, script, solvers):
+    calls, proc = [], None
+    cur, last_print = None, ""
+    cached, backend, memcap = False, None, None
+    seen = {}
+    for line in open(path, errors="replace"):
+        line = line.rstrip("\n")
+        at = line.find(MARK)
+        if at < 0:
+            if cur is not None:
+                m = SHARED.search(line)
+                if m and not UNSHARED.search(line):
+                    cur["sizes"].append(int(m.group(1)))
+                    continue
+                if UNSHARED.search(line):
+                    continue
+            if line.strip() and not SAW_INFO.match(line):
+                last_print = line.strip()
+            continue
+        words = line[at + len(MARK):].split()
+        if not words:
+            continue
+        if words[0] == "begin" and len(words) >= 3:
+            kind, name = words[1], " ".join(words[2:])
+            if kind == "prove_print":
+                name = last_print or "-"
+            cur = {"kind": kind, "name": name, "sizes": []}
+        elif words[0] == "end" and cur is not None:
+            calls.append(finish(script, cur, int(words[-1]), "ok", seen, solvers))
+            cur = None
+        elif words[0] == "process" and len(words) == 3:
+            proc = {"script": script, "kind": "process", "ms": int(words[1]),
+                    "peak_rss_kb": int(words[2])}
+        elif words[0] == "memlimit" and len(words) >= 3:
+            memcap = {"rss_kb": int(words[1]), "limit_kb": int(words[2]),
+                      "call": " ".join(words[3:]) or "-"}
+        elif words[0] == "cached":
+            cached = True
+        elif words[0] == "solver" and len(words) == 2:
+            backend = words[1]
+    if cur is not None:
+        calls.append(finish(script, cur, None, "fail", seen, solvers))
+    if proc:
+        proc["memcap"] = memcap
+    for r in calls + ([proc] if proc else []):
+        r["cached"] = cached
+        if backend and r.get("solver"):
+            r["solver"] = re.sub(r"\bportfolio\b", f"portfolio={backend}", r["solver"])
+    return calls, proc
+
+
+def finish(script, cur, ms, status, seen, solvers):
+    key = (cur["kind"], cur["name"])
+    seen[key] = seen.get(key, 0) + 1
+    if cur["kind"] == "llvm_verify":
+        solver = solvers.llvm_verify(cur["name"])
+    else:
+        solver = solvers.prove_print(cur["name"])
+    return {"script": script, "kind": cur["kind"], "name": cur["name"],
+            "index": seen[key], "solver": solver, "ms": ms,
+            "goals": len(cur["sizes"]),
+            "goal_size_max": max(cur["sizes"], default=None),
+            "goal_size_total": sum(cur["sizes"]), "status": status}
+
+
+def collect(logdir, root):
+    records = []
+    for dirpath, _, files in os.walk(logdir):
+        for f in sorted(files):
+            if not f.endswith(".log"):
+                continue
+            rel = os.path.relpath(os.path.join(dirpath, f), logdir)
+            script = rel[:-len(".log")] + ".saw"
+            solvers = Solvers(saw_sources(os.path.join(root, script)))
+            calls, proc = parse_log(os.path.join(dirpath, f), script, solvers)
+            records += calls + ([proc] if proc else [])
+    return records
+
+
+def key(r):
+    return (r["script"], r["kind"], r.get("name"), r.get("index"))
+
+
+def human_ms(ms):
+    if ms is None:
+        return "-"
+    if ms >= 60000:
+        return f"{ms / 60000:.1f}m"
+    if ms >= 1000:
+        return f"{ms / 1000:.1f}s"
+    return f"{ms}ms"
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("logdir")
+    ap.add_argument("--root", default=".",
+                    help="repository root the log paths are relative to")
+    ap.add_argument("--jsonl", help="write every record to this file")
+    ap.add_argument("--top", type=int, default=30,
+                    help="calls to list, slowest first (default 30, 0 = all)")
+    ap.add_argument("--baseline")
+    ap.add_argument("--tolerance", type=float, default=25.0,
+                    help="allowed slowdown vs baseline, percent (default 25)")
+    ap.add_argument("--min-ms", type=int, default=1000,
+                    help="ignore calls faster than this in both runs (default 1000)")
+    ap.add_argument("--warn-only", action="store_true",
+                    help="report regressions without failing")
+    args = ap.parse_args()
+
+    if not os.path.isdir(args.logdir):
+        print(f"{args.logdir}: no logs yet, run make verify first", file=sys.stderr)
+        return 1
+    records = collect(args.logdir, args.root)
+    if args.jsonl:
+        with open(args.jsonl, "w") as f:
+            for r in records:
+                f.write(json.dumps(r) + "\n")
+
+    base = {}
+    if args.baseline:
+        with open(args.baseline) as f:
+            for line in f:
+                if line.strip():
+                    r = json.loads(line)
+                    base[key(r)] = r
+
+    calls = [r for r in records if r["kind"] != "process"]
+    calls.sort(key=lambda r: -(r["ms"] if r["ms"] is not None else 1 << 62))
+    shown = calls if args.top == 0 else calls[:args.top]
+    print(f"{'time':>7} {'goals':>5} {'max size':>9} {'solver':<14} {'call':<60} {'vs base':>8}")
+    regressions = []
+    for r in calls:
+        delta = "       -"
+        b = base.get(key(r))
+        if b is not None and r["ms"] is not None and b["ms"]:
+            pct = (r["ms"] - b["ms"]) / b["ms"] * 100.0
+            delta = f"{pct:+7.1f}%"
+            if pct > args.tolerance and max(r["ms"], b["ms"]) >= args.min_ms:
+                regressions.append((r, pct))
+        if r in shown:
+            name = r["name"] if r["index"] == 1 else f"{r['name']} #{r['index']}"
+            call = f"{os.path.basename(r['script'])}: {r['kind']} {name}"
+            flags = (" FAIL" if r["status"] == "fail" else "") + (" (cached)" if r["cached"] else "")
+            size = r["goal_size_max"] if r["goal_size_max"] is not None else "-"
+            print(f"{human_ms(r['ms']):>7} {r['goals']:>5} {size:>9} {r['solver'] or '?':<14} "
+                  f"{(call + flags)[:60]:<60} {delta}")
+    if len(shown) < len(calls):
+        print(f"({len(calls) - len(shown)} faster calls not shown, --top 0 for all)")
+
+    print("")
+    print(f"{'wall':>7} {'peak RSS':>9}  script")
+    procs = sorted((r for r in records if r["kind"] == "process"), key=lambda r: -r["ms"])
+    for r in procs:
+        cap = r.get("memcap")
+        print(f"{human_ms(r['ms']):>7} {r['peak_rss_kb'] / 1024:8.0f}M  {r['script']}"
+              + (" (cached)" if r["cached"] else "")
+              + (f" MEMCAP (limit {cap['limit_kb'] // 1024}M, in {cap['call']})" if cap else ""))
+
+    if regressions:
+        print("")
+        for r, pct in regressions:
+            print(f"REGRESSION: {r['script']}: {r['kind']} {r['name']} "
+                  f"{pct:+.1f}% (tolerance {args.tolerance:.0f}%)")
+        return 0 if args.warn_only else 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())